@@ -0,0 +1,525 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BigInteger.h"
+#include "BigIntegerBatch.h"
+#include "BigIntegerExpression.h"
+#include "BigIntegerProfiler.h"
+#include "BigIntegerSimd.h"
+
+#ifndef BIGINTEGER_WORST_CASE_PATH
+#define BIGINTEGER_WORST_CASE_PATH "worst_case.txt"
+#endif
+
+namespace
+{
+	struct Options
+	{
+		std::string output;
+		std::string filter;
+		std::string worstCasePath = BIGINTEGER_WORST_CASE_PATH;
+		size_t maxLimbs = 1000000;
+		size_t worstCaseChars = 20000;
+		double minTimeMs = 50.0;
+		double maxCaseMs = 2000.0;
+	};
+
+	struct Result
+	{
+		std::string name;
+		std::string unit;
+		size_t size;
+		size_t iterations;
+		double nsPerOp;
+		bool skipped;
+	};
+
+	// keeps results alive so the measured work is not optimized away
+	volatile size_t g_sink = 0;
+
+	void Consume(const BigInteger& number)
+	{
+		g_sink = g_sink + (number == 0 ? 1 : 2);
+	}
+
+	std::string RandomDigits(std::mt19937_64& random, size_t limbs)
+	{
+		std::uniform_int_distribution<int> digit{ 0, 9 };
+		std::string text(limbs * 9, '0');
+
+		for (char& c : text)
+		{
+			c = static_cast<char>('0' + digit(random));
+		}
+
+		text[0] = static_cast<char>('1' + digit(random) % 9);
+
+		return text;
+	}
+
+	// repeats body until minTimeMs has passed, return nanoseconds per call
+	double Measure(const Options& options, const std::function<void()>& body, size_t& iterations)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		iterations = 0;
+		size_t batch = 1;
+		const Clock::time_point start = Clock::now();
+		double elapsedNs = 0.0;
+
+		while (true)
+		{
+			for (size_t i = 0; i < batch; ++i)
+			{
+				body();
+			}
+
+			iterations += batch;
+			elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+			if (elapsedNs >= options.minTimeMs * 1e6)
+			{
+				break;
+			}
+
+			batch *= 2;
+		}
+
+		return elapsedNs / static_cast<double>(iterations);
+	}
+
+	class Suite
+	{
+	private:
+		const Options& m_options;
+		std::vector<Result> m_results;
+		std::mt19937_64 m_random{ 20240601 };
+
+	public:
+		explicit Suite(const Options& options)
+			: m_options{ options }
+		{
+
+		}
+
+		const std::vector<Result>& GetResults() const
+		{
+			return m_results;
+		}
+
+		// runs the case for growing sizes, skipping sizes whose extrapolated cost exceeds maxCaseMs
+		void Run(const std::string& name, double growthExponent,
+			const std::function<std::function<void()>(std::mt19937_64&, size_t)>& prepare)
+		{
+			if (!m_options.filter.empty() && name.find(m_options.filter) == std::string::npos)
+			{
+				return;
+			}
+
+			double previousNs = 0.0;
+			size_t previousLimbs = 0;
+
+			for (size_t limbs = 1; limbs <= m_options.maxLimbs; limbs *= 10)
+			{
+				if (previousLimbs > 0)
+				{
+					const double ratio = static_cast<double>(limbs) / static_cast<double>(previousLimbs);
+					const double estimateMs = previousNs * std::pow(ratio, growthExponent) / 1e6;
+
+					if (estimateMs > m_options.maxCaseMs)
+					{
+						m_results.push_back({ name, "limbs", limbs, 0, 0.0, true });
+
+						continue;
+					}
+				}
+
+				const std::function<void()> body = prepare(m_random, limbs);
+
+				size_t iterations = 0;
+				const double ns = Measure(m_options, body, iterations);
+
+				m_results.push_back({ name, "limbs", limbs, iterations, ns, false });
+				std::cerr << name << " " << limbs << " limbs: " << ns << " ns/op\n";
+
+				previousNs = ns;
+				previousLimbs = limbs;
+			}
+		}
+
+		void RunBinary(const std::string& name, double growthExponent, size_t leftScale,
+			const std::function<BigInteger(const BigInteger&, const BigInteger&)>& operation)
+		{
+			Run(name, growthExponent, [operation, leftScale](std::mt19937_64& random, size_t limbs)
+				{
+					const BigInteger a{ RandomDigits(random, limbs * leftScale) };
+					const BigInteger b{ RandomDigits(random, limbs) };
+
+					return std::function<void()>{ [operation, a, b]()
+						{
+							Consume(operation(a, b));
+						} };
+				});
+		}
+
+		void RunWorstCase()
+		{
+			const std::string name = "worst_case";
+
+			if (!m_options.filter.empty() && name.find(m_options.filter) == std::string::npos)
+			{
+				return;
+			}
+
+			std::ifstream file{ m_options.worstCasePath };
+			std::string query;
+
+			if (!file || !(file >> query))
+			{
+				std::cerr << "worst_case: cannot read " << m_options.worstCasePath << "\n";
+				m_results.push_back({ name, "chars", 0, 0, 0.0, true });
+
+				return;
+			}
+
+			if (m_options.worstCaseChars > 0 && query.size() > m_options.worstCaseChars)
+			{
+				query.resize(m_options.worstCaseChars);
+			}
+
+			// the Baekjoon driver from baekjun.txt, quadratic in the input length
+			const std::function<void()> body = [query]()
+				{
+					std::string x;
+					x.reserve(query.size());
+
+					BigInteger s;
+
+					for (char c : query)
+					{
+						if (c == '-')
+						{
+							std::reverse(x.begin(), x.end());
+						}
+						else
+						{
+							x += c;
+							s += BigInteger(x);
+						}
+					}
+
+					Consume(s);
+				};
+
+			size_t iterations = 0;
+			const double ns = Measure(m_options, body, iterations);
+
+			m_results.push_back({ name, "chars", query.size(), iterations, ns, false });
+			std::cerr << name << " " << query.size() << " chars: " << ns << " ns/op\n";
+
+			// the same text read as arithmetic by the streaming evaluator, linear in its length. The file ends
+			// in an operator, which the evaluator is told to drop.
+			BigInteger value;
+
+			if (!BigIntegerExpressionEvaluator::Evaluate(query, value, true))
+			{
+				std::cerr << name << "_expression: the evaluator rejects the input\n";
+				m_results.push_back({ name + "_expression", "chars", query.size(), 0, 0.0, true });
+
+				return;
+			}
+
+			const std::function<void()> expression = [query]()
+				{
+					BigInteger value;
+
+					BigIntegerExpressionEvaluator::Evaluate(query, value, true);
+					Consume(value);
+				};
+
+			const double expressionNs = Measure(m_options, expression, iterations);
+
+			m_results.push_back({ name + "_expression", "chars", query.size(), iterations, expressionNs, false });
+			std::cerr << name << "_expression " << query.size() << " chars: " << expressionNs << " ns/op\n";
+		}
+	};
+
+	const char* GetInstructionSetName(BigIntegerSimd::InstructionSet instructionSet)
+	{
+		switch (instructionSet)
+		{
+		case BigIntegerSimd::InstructionSet::Avx512:
+			return "avx512";
+		case BigIntegerSimd::InstructionSet::Avx2:
+			return "avx2";
+		default:
+			return "scalar";
+		}
+	}
+
+	std::string ToJson(const std::vector<Result>& results)
+	{
+		std::ostringstream oss;
+
+		oss << "{\n";
+		oss << "  \"schema\": 1,\n";
+		oss << "  \"instruction_set\": \"" << GetInstructionSetName(BigIntegerSimd::GetInstructionSet()) << "\",\n";
+		oss << "  \"results\": [\n";
+
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			const Result& result = results[i];
+
+			oss << "    { \"name\": \"" << result.name << "\", \"" << result.unit << "\": " << result.size;
+
+			if (result.skipped)
+			{
+				oss << ", \"skipped\": true }";
+			}
+			else
+			{
+				oss << ", \"iterations\": " << result.iterations << ", \"ns_per_op\": " << result.nsPerOp << " }";
+			}
+
+			oss << (i + 1 < results.size() ? ",\n" : "\n");
+		}
+
+		oss << "  ]";
+
+		if (BigIntegerProfiler::IsEnabled())
+		{
+			oss << ",\n  \"profile\": " << BigIntegerProfiler::TakeSnapshot().ToJson();
+		}
+
+		oss << "\n}\n";
+
+		return oss.str();
+	}
+
+	void PrintUsage()
+	{
+		std::cerr << "usage: BigIntegerBenchmark [--output file] [--filter name] [--max-limbs n]\n"
+			"       [--min-time-ms t] [--max-case-ms t] [--instruction-set scalar|avx2|avx512]\n"
+			"       [--worst-case path] [--worst-case-chars n (0 = whole file)]\n";
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string argument = argv[i];
+
+			if (i + 1 >= argc)
+			{
+				return false;
+			}
+
+			const std::string value = argv[++i];
+
+			if (argument == "--output")
+			{
+				options.output = value;
+			}
+			else if (argument == "--filter")
+			{
+				options.filter = value;
+			}
+			else if (argument == "--max-limbs")
+			{
+				options.maxLimbs = std::stoull(value);
+			}
+			else if (argument == "--min-time-ms")
+			{
+				options.minTimeMs = std::stod(value);
+			}
+			else if (argument == "--max-case-ms")
+			{
+				options.maxCaseMs = std::stod(value);
+			}
+			else if (argument == "--worst-case")
+			{
+				options.worstCasePath = value;
+			}
+			else if (argument == "--worst-case-chars")
+			{
+				options.worstCaseChars = std::stoull(value);
+			}
+			else if (argument == "--instruction-set")
+			{
+				if (value == "scalar")
+				{
+					BigIntegerSimd::SetInstructionSet(BigIntegerSimd::InstructionSet::Scalar);
+				}
+				else if (value == "avx2")
+				{
+					BigIntegerSimd::SetInstructionSet(BigIntegerSimd::InstructionSet::Avx2);
+				}
+				else if (value == "avx512")
+				{
+					BigIntegerSimd::SetInstructionSet(BigIntegerSimd::InstructionSet::Avx512);
+				}
+				else
+				{
+					return false;
+				}
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+
+		return 1;
+	}
+
+	Suite suite{ options };
+
+	suite.Run("construct", 1.0, [](std::mt19937_64& random, size_t limbs)
+		{
+			const std::string text = RandomDigits(random, limbs);
+
+			return std::function<void()>{ [text]()
+				{
+					Consume(BigInteger(text));
+				} };
+		});
+
+	suite.Run("to_string", 1.0, [](std::mt19937_64& random, size_t limbs)
+		{
+			const BigInteger number{ RandomDigits(random, limbs) };
+
+			return std::function<void()>{ [number]()
+				{
+					g_sink = g_sink + number.ToString().size();
+				} };
+		});
+
+	suite.Run("construct_parallel", 1.0, [](std::mt19937_64& random, size_t limbs)
+		{
+			const std::string text = RandomDigits(random, limbs);
+
+			return std::function<void()>{ [text]()
+				{
+					Consume(BigInteger::ParseParallel(text));
+				} };
+		});
+
+	suite.Run("to_string_parallel", 1.0, [](std::mt19937_64& random, size_t limbs)
+		{
+			const BigInteger number{ RandomDigits(random, limbs) };
+
+			return std::function<void()>{ [number]()
+				{
+					g_sink = g_sink + number.ToStringParallel().size();
+				} };
+		});
+
+	suite.RunBinary("add", 1.0, 1, [](const BigInteger& a, const BigInteger& b) { return a + b; });
+	suite.RunBinary("subtract", 1.0, 1, [](const BigInteger& a, const BigInteger& b) { return a - b; });
+	suite.RunBinary("multiply", 2.0, 1, [](const BigInteger& a, const BigInteger& b) { return a * b; });
+	suite.RunBinary("divide", 2.0, 2, [](const BigInteger& a, const BigInteger& b) { return a / b; });
+	suite.RunBinary("modulo", 2.0, 2, [](const BigInteger& a, const BigInteger& b) { return a % b; });
+
+	suite.RunBinary("add_uint32", 1.0, 1, [](const BigInteger& a, const BigInteger&) { return a + 123456789U; });
+	suite.RunBinary("multiply_uint32", 1.0, 1, [](const BigInteger& a, const BigInteger&) { return a * 123456789U; });
+	suite.RunBinary("divide_uint32", 1.0, 1, [](const BigInteger& a, const BigInteger&) { return a / 10U; });
+	suite.RunBinary("modulo_int64", 1.0, 1, [](const BigInteger& a, const BigInteger&) { return a % static_cast<std::int64_t>(1000000007); });
+
+	suite.Run("compare", 1.0, [](std::mt19937_64& random, size_t limbs)
+		{
+			const BigInteger a{ RandomDigits(random, limbs) };
+			const BigInteger b = a + 1;
+
+			return std::function<void()>{ [a, b]()
+				{
+					g_sink = g_sink + ((a <=> b) < 0 ? 1 : 2);
+				} };
+		});
+
+	suite.Run("compare_int64", 1.0, [](std::mt19937_64& random, size_t limbs)
+		{
+			const BigInteger a{ RandomDigits(random, limbs) };
+
+			return std::function<void()>{ [a]()
+				{
+					g_sink = g_sink + (a < static_cast<std::int64_t>(1234567890123LL) ? 1 : 2);
+				} };
+		});
+
+	// many 4 limb numbers, the size counts limbs over the whole batch
+	const auto prepareBatch = [](std::mt19937_64& random, size_t limbs, BigIntegerBatch& a, BigIntegerBatch& b)
+		{
+			for (size_t i = 0; i < std::max<size_t>(limbs / 4, 1); ++i)
+			{
+				a.PushBack(BigInteger{ RandomDigits(random, 2) }.GetView());
+				b.PushBack((-BigInteger{ RandomDigits(random, 2) }).GetView());
+			}
+		};
+
+	suite.Run("batch_add", 1.0, [prepareBatch](std::mt19937_64& random, size_t limbs)
+		{
+			BigIntegerBatch a{ 4 };
+			BigIntegerBatch b{ 4 };
+
+			prepareBatch(random, limbs, a, b);
+
+			return std::function<void()>{ [a, b]()
+				{
+					BigIntegerBatch out{ 4 };
+
+					g_sink = g_sink + (BigIntegerBatch::Add(a, b, out) ? 1 : 2);
+				} };
+		});
+
+	suite.Run("batch_multiply", 1.0, [prepareBatch](std::mt19937_64& random, size_t limbs)
+		{
+			BigIntegerBatch a{ 4 };
+			BigIntegerBatch b{ 4 };
+
+			prepareBatch(random, limbs, a, b);
+
+			return std::function<void()>{ [a, b]()
+				{
+					BigIntegerBatch out{ 4 };
+
+					g_sink = g_sink + (BigIntegerBatch::Multiply(a, b, out) ? 1 : 2);
+				} };
+		});
+
+	suite.RunWorstCase();
+
+	const std::string json = ToJson(suite.GetResults());
+
+	if (options.output.empty())
+	{
+		std::cout << json;
+	}
+	else
+	{
+		std::ofstream output{ options.output };
+		output << json;
+	}
+
+	return 0;
+}
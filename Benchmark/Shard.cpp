@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BigInteger.h"
+#include "BigIntegerShardPool.h"
+
+namespace
+{
+	struct Options
+	{
+		size_t workers = BigIntegerShardPool::TASK_COUNT;
+		std::vector<int> cpus;
+		size_t limbs = 1000000;
+		size_t repeat = 3;
+	};
+
+	BigInteger RandomNumber(std::mt19937_64& random, size_t limbs)
+	{
+		std::uniform_int_distribution<int> digit{ 0, 9 };
+		std::string text(limbs * 9, '0');
+
+		for (char& c : text)
+		{
+			c = static_cast<char>('0' + digit(random));
+		}
+
+		text[0] = std::max(text[0], '1');
+
+		return BigInteger{ text };
+	}
+
+	// "0,8,16" to its CPU numbers, return false on anything else
+	bool ParseCpus(const std::string& text, std::vector<int>& cpus)
+	{
+		size_t begin = 0;
+
+		while (begin <= text.size())
+		{
+			const size_t end = std::min(text.find(',', begin), text.size());
+			const std::string number = text.substr(begin, end - begin);
+
+			if (number.empty() || number.find_first_not_of("0123456789") != std::string::npos)
+			{
+				return false;
+			}
+
+			cpus.push_back(std::stoi(number));
+			begin = end + 1;
+		}
+
+		return true;
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string argument = argv[i];
+
+			if (i + 1 >= argc)
+			{
+				return false;
+			}
+
+			const std::string value = argv[++i];
+
+			if (argument == "--workers")
+			{
+				options.workers = std::max<size_t>(std::stoull(value), 1);
+			}
+			else if (argument == "--cpus")
+			{
+				if (!ParseCpus(value, options.cpus))
+				{
+					return false;
+				}
+			}
+			else if (argument == "--limbs")
+			{
+				options.limbs = std::max<size_t>(std::stoull(value), 1);
+			}
+			else if (argument == "--repeat")
+			{
+				options.repeat = std::max<size_t>(std::stoull(value), 1);
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void PrintUsage()
+	{
+		std::cerr << "usage: BigIntegerShard [--workers n] [--cpus 0,8,16,...] [--limbs n] [--repeat n]\n"
+			"       multiplies two random n limb numbers in process and through n worker processes,\n"
+			"       worker i is pinned to the i-th listed CPU, and checks that the products agree\n";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+
+		return 1;
+	}
+
+	// the workers are forked before anything else runs
+	BigIntegerShardPool pool{ options.workers, options.cpus };
+
+	if (!pool.IsRunning())
+	{
+		std::cerr << "no worker processes, products are computed in process\n";
+	}
+
+	std::mt19937_64 random{ 20240601 };
+	const BigInteger a = RandomNumber(random, options.limbs);
+	const BigInteger b = -RandomNumber(random, options.limbs);
+
+	using Clock = std::chrono::steady_clock;
+
+	for (size_t run = 0; run < options.repeat; ++run)
+	{
+		const Clock::time_point start = Clock::now();
+		const BigInteger local = a * b;
+		const Clock::time_point middle = Clock::now();
+		const BigInteger sharded = pool.Multiply(a, b);
+		const Clock::time_point end = Clock::now();
+
+		if (sharded != local)
+		{
+			std::cerr << "sharded product differs from the in process product\n";
+
+			return 1;
+		}
+
+		std::cout << options.limbs << " limbs, " << pool.GetWorkerCount() << " workers: in process "
+			<< std::chrono::duration<double, std::milli>(middle - start).count() << " ms, sharded "
+			<< std::chrono::duration<double, std::milli>(end - middle).count() << " ms\n";
+	}
+
+	return 0;
+}
@@ -0,0 +1,297 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BigInteger.h"
+#include "BigIntegerLimbs.h"
+#include "BigIntegerRadix.h"
+#include "BigIntegerThresholds.h"
+
+namespace
+{
+	constexpr size_t DISABLED = std::numeric_limits<size_t>::max();
+
+	struct Options
+	{
+		std::string output = "bigint_thresholds.txt";
+		double minTimeMs = 20.0;
+		// a crossover has to hold for this many sizes in a row, so one noisy sample does not decide it
+		size_t confirmations = 2;
+	};
+
+	volatile size_t g_sink = 0;
+
+	std::vector<std::uint32_t> RandomLimbs(std::mt19937_64& random, size_t limbs)
+	{
+		std::uniform_int_distribution<std::uint32_t> digit{ 0, 999999999 };
+		std::vector<std::uint32_t> result(limbs);
+
+		for (std::uint32_t& limb : result)
+		{
+			limb = digit(random);
+		}
+
+		result.back() = std::max<std::uint32_t>(result.back(), 1);
+
+		return result;
+	}
+
+	// best of three runs sharing minTimeMs, return nanoseconds per call
+	double Measure(const Options& options, const std::function<void()>& body)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		double best = std::numeric_limits<double>::max();
+
+		for (int run = 0; run < 3; ++run)
+		{
+			size_t iterations = 0;
+			size_t batch = 1;
+			const Clock::time_point start = Clock::now();
+			double elapsedNs = 0.0;
+
+			while (elapsedNs < options.minTimeMs * 1e6 / 3)
+			{
+				for (size_t i = 0; i < batch; ++i)
+				{
+					body();
+				}
+
+				iterations += batch;
+				elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+				batch *= 2;
+			}
+
+			best = std::min(best, elapsedNs / static_cast<double>(iterations));
+		}
+
+		return best;
+	}
+
+	// runs body with the thresholds changed by apply, restoring the base thresholds afterwards
+	double MeasureWith(const Options& options, const BigIntegerThresholds& base,
+		const std::function<void(BigIntegerThresholds&)>& apply, const std::function<void()>& body)
+	{
+		BigIntegerThresholds thresholds = base;
+
+		apply(thresholds);
+		BigIntegerTuning::SetThresholds(thresholds);
+
+		const double ns = Measure(options, body);
+
+		BigIntegerTuning::SetThresholds(base);
+
+		return ns;
+	}
+
+	// walks the sizes upwards and returns the first one from which the faster tier wins confirmations times
+	// in a row, or fallback when it never does
+	size_t FindCrossover(const Options& options, const std::string& name, const std::vector<size_t>& sizes, size_t fallback,
+		const std::function<std::pair<double, double>(size_t)>& compare)
+	{
+		size_t wins = 0;
+
+		for (size_t i = 0; i < sizes.size(); ++i)
+		{
+			const auto [slowTier, fastTier] = compare(sizes[i]);
+
+			std::cerr << name << ' ' << sizes[i] << ": " << slowTier << " ns vs " << fastTier << " ns\n";
+
+			wins = fastTier < slowTier ? wins + 1 : 0;
+
+			if (wins == options.confirmations)
+			{
+				return sizes[i + 1 - wins];
+			}
+		}
+
+		return fallback;
+	}
+
+	std::vector<size_t> GeometricSizes(size_t first, size_t last, double factor)
+	{
+		std::vector<size_t> sizes;
+
+		for (double size = static_cast<double>(first); size <= static_cast<double>(last); size *= factor)
+		{
+			if (sizes.empty() || static_cast<size_t>(size) != sizes.back())
+			{
+				sizes.push_back(static_cast<size_t>(size));
+			}
+		}
+
+		return sizes;
+	}
+
+	// n x n multiplication, the shorter operand decides the tier
+	std::pair<double, double> CompareMultiply(const Options& options, const BigIntegerThresholds& base, std::mt19937_64& random,
+		size_t limbs, size_t BigIntegerThresholds::* member)
+	{
+		const std::vector<std::uint32_t> a = RandomLimbs(random, limbs);
+		const std::vector<std::uint32_t> b = RandomLimbs(random, limbs);
+		std::vector<std::uint32_t> out(limbs * 2);
+
+		const auto body = [&]()
+		{
+			g_sink = g_sink + BigIntegerLimbs::Multiply(a, b, out);
+		};
+
+		const double below = MeasureWith(options, base, [&](BigIntegerThresholds& t) { t.*member = limbs + 1; }, body);
+		const double above = MeasureWith(options, base, [&](BigIntegerThresholds& t) { t.*member = limbs; }, body);
+
+		return { below, above };
+	}
+
+	size_t TuneKaratsuba(const Options& options, BigIntegerThresholds base, std::mt19937_64& random)
+	{
+		base.nttLimbs = DISABLED;
+
+		// with the threshold at n only the top level splits, its halves go back to schoolbook
+		return FindCrossover(options, "karatsuba", GeometricSizes(8, 512, 1.25), 512, [&](size_t limbs)
+		{
+			return CompareMultiply(options, base, random, limbs, &BigIntegerThresholds::karatsubaLimbs);
+		});
+	}
+
+	size_t TuneNtt(const Options& options, const BigIntegerThresholds& base, std::mt19937_64& random)
+	{
+		return FindCrossover(options, "ntt", GeometricSizes(128, 65536, 1.4), 65536, [&](size_t limbs)
+		{
+			return CompareMultiply(options, base, random, limbs, &BigIntegerThresholds::nttLimbs);
+		});
+	}
+
+	size_t TuneRadix(const Options& options, const BigIntegerThresholds& base, std::mt19937_64& random)
+	{
+		return FindCrossover(options, "radix", GeometricSizes(8, 4096, 1.5), 4096, [&](size_t limbs)
+		{
+			const std::vector<std::uint32_t> digits = RandomLimbs(random, limbs);
+
+			// one conversion each way, the split has both halves fall back to Horner
+			const auto body = [&]()
+			{
+				const std::vector<std::uint32_t> words = BigIntegerRadix::ToWords(digits);
+
+				g_sink = g_sink + words.size() + (BigIntegerRadix::FromWords(words, false) == 0 ? 1 : 2);
+			};
+
+			const double horner = MeasureWith(options, base, [&](BigIntegerThresholds& t) { t.radixBasecaseLimbs = limbs; }, body);
+			const double split = MeasureWith(options, base, [&](BigIntegerThresholds& t) { t.radixBasecaseLimbs = (limbs + 1) / 2; }, body);
+
+			return std::pair<double, double>{ horner, split };
+		});
+	}
+
+	size_t TuneParallelText(const Options& options, const BigIntegerThresholds& base, std::mt19937_64& random)
+	{
+		const size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+		if (threads == 1)
+		{
+			std::cerr << "parallel text: single hardware thread, keeping " << base.parallelTextLimbs << '\n';
+
+			return base.parallelTextLimbs;
+		}
+
+		// per thread sizes, each case splits a number of threads times that many limbs across all threads
+		return FindCrossover(options, "parallel text", GeometricSizes(256, 262144, 2.0), DISABLED, [&](size_t limbs)
+		{
+			const std::vector<std::uint32_t> digits = RandomLimbs(random, limbs * threads);
+			const std::string text = BigIntegerView{ digits, false }.ToString();
+
+			const auto body = [&]()
+			{
+				const BigInteger parsed = BigInteger::ParseParallel(text);
+
+				g_sink = g_sink + parsed.ToStringParallel().size();
+			};
+
+			const double serial = MeasureWith(options, base, [&](BigIntegerThresholds& t) { t.parallelTextLimbs = DISABLED; }, body);
+			const double parallel = MeasureWith(options, base, [&](BigIntegerThresholds& t) { t.parallelTextLimbs = limbs; }, body);
+
+			return std::pair<double, double>{ serial, parallel };
+		});
+	}
+
+	void PrintUsage()
+	{
+		std::cerr << "usage: BigIntegerTune [--output file] [--min-time-ms t] [--confirmations n]\n"
+			"       the output is loaded by BigIntegerTuning::LoadThresholds or through BIGINTEGER_THRESHOLDS\n";
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string argument = argv[i];
+
+			if (i + 1 >= argc)
+			{
+				return false;
+			}
+
+			const std::string value = argv[++i];
+
+			if (argument == "--output")
+			{
+				options.output = value;
+			}
+			else if (argument == "--min-time-ms")
+			{
+				options.minTimeMs = std::stod(value);
+			}
+			else if (argument == "--confirmations")
+			{
+				options.confirmations = std::max<size_t>(std::stoull(value), 1);
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+
+		return 1;
+	}
+
+	std::mt19937_64 random{ 20240601 };
+
+	// each tier is tuned on top of the ones below it
+	BigIntegerThresholds thresholds;
+
+	thresholds.karatsubaLimbs = TuneKaratsuba(options, thresholds, random);
+	thresholds.nttLimbs = TuneNtt(options, thresholds, random);
+	thresholds.radixBasecaseLimbs = TuneRadix(options, thresholds, random);
+	thresholds.parallelTextLimbs = TuneParallelText(options, thresholds, random);
+
+	BigIntegerTuning::SetThresholds(thresholds);
+
+	if (!BigIntegerTuning::SaveThresholds(options.output, thresholds))
+	{
+		std::cerr << "failed to write " << options.output << '\n';
+
+		return 1;
+	}
+
+	std::cout << BigIntegerTuning::ToText(thresholds);
+
+	return 0;
+}
@@ -1,7 +1,48 @@
 #include "BigInteger.h"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
-#include <sstream>
+#include <string_view>
+
+#include "BigIntegerArithmetic.h"
+#include "BigIntegerLimbs.h"
+#include "BigIntegerParallel.h"
+#include "BigIntegerRadix.h"
+#include "BigIntegerSimd.h"
+#include "BigIntegerThresholds.h"
+
+namespace
+{
+	// significance 0 is the least significant byte, return its offset in a buffer of wordCount words
+	size_t GetByteOffset(size_t significance, size_t wordCount, WordOrder order, size_t wordSize, ByteOrder endian)
+	{
+		if (endian == ByteOrder::Native)
+		{
+			endian = std::endian::native == std::endian::little ? ByteOrder::LittleEndian : ByteOrder::BigEndian;
+		}
+
+		const size_t word = significance / wordSize;
+		const size_t byte = significance % wordSize;
+
+		return (order == WordOrder::MostSignificantFirst ? wordCount - 1 - word : word) * wordSize
+			+ (endian == ByteOrder::BigEndian ? wordSize - 1 - byte : byte);
+	}
+
+	// out[i] = (digits[i] + digits[i + 1] * BASE) / DIVISOR for a power of ten DIVISOR
+	template <std::uint32_t DIVISOR>
+	void ShiftDigitsDown(const std::uint32_t* digits, size_t size, std::uint32_t* out)
+	{
+		constexpr std::uint32_t UPPER = 1000000000U / DIVISOR;
+
+		for (size_t i = 0; i + 1 < size; ++i)
+		{
+			out[i] = digits[i] / DIVISOR + digits[i + 1] % DIVISOR * UPPER;
+		}
+
+		out[size - 1] = digits[size - 1] / DIVISOR;
+	}
+}
 
 BigInteger::BigInteger()
 	: m_digits{ 0 }, m_isNegative{ false }
@@ -89,6 +130,8 @@ BigInteger::BigInteger(std::uint64_t number)
 
 BigInteger::BigInteger(const std::string& number)
 {
+	BIGINTEGER_PROFILE_KERNEL(Parse, number.size() / 9);
+
 	if (number.empty() || !IsValid(number))
 	{
 		m_digits.push_back(0);
@@ -121,6 +164,12 @@ BigInteger::BigInteger(const std::string& number)
 	Normalize();
 }
 
+BigInteger::BigInteger(const BigIntegerView& view)
+	: m_digits{ Digits(view.GetDigits().begin(), view.GetDigits().end()) }, m_isNegative{ view.IsNegative() }
+{
+	Normalize();
+}
+
 BigInteger::BigInteger(const BigInteger& other)
 	: m_digits{ other.m_digits }, m_isNegative{ other.m_isNegative }
 {
@@ -154,13 +203,13 @@ BigInteger::BigInteger(Digits&& digits, bool isNegative)
 	
 }
 
-BigInteger::BigInteger(const Digits& digits, bool isNegative)
+BigInteger::BigInteger(const DigitStorage& digits, bool isNegative)
 	: m_digits{ digits }, m_isNegative{ isNegative }
 {
 
 }
 
-BigInteger BigInteger::operator+(const BigInteger& other) const
+BigInteger BigInteger::operator+(const BigInteger& other) const&
 {
 	Digits temp;
 	bool negative = false;
@@ -193,27 +242,68 @@ BigInteger BigInteger::operator+(const BigInteger& other) const
 	return result;
 }
 
-BigInteger BigInteger::operator+(std::int32_t other) const
+BigInteger BigInteger::operator+(const BigInteger& other) &&
+{
+	return std::move(*this += other);
+}
+
+BigInteger BigInteger::operator+(BigInteger&& other) const&
+{
+	return std::move(other += *this);
+}
+
+BigInteger BigInteger::operator+(BigInteger&& other) &&
+{
+	// add into the expiring operand with the larger buffer
+	if (other.m_digits.capacity() > m_digits.capacity())
+	{
+		return std::move(other += *this);
+	}
+
+	return std::move(*this += other);
+}
+
+BigInteger BigInteger::operator+(std::int32_t other) const&
 {
 	return *this + BigInteger(other);
 }
 
-BigInteger BigInteger::operator+(std::uint32_t other) const
+BigInteger BigInteger::operator+(std::int32_t other) &&
+{
+	return std::move(*this += other);
+}
+
+BigInteger BigInteger::operator+(std::uint32_t other) const&
 {
 	return *this + BigInteger(other);
 }
 
-BigInteger BigInteger::operator+(std::int64_t other) const
+BigInteger BigInteger::operator+(std::uint32_t other) &&
+{
+	return std::move(*this += other);
+}
+
+BigInteger BigInteger::operator+(std::int64_t other) const&
 {
 	return *this + BigInteger(other);
 }
 
-BigInteger BigInteger::operator+(std::uint64_t other) const
+BigInteger BigInteger::operator+(std::int64_t other) &&
+{
+	return std::move(*this += other);
+}
+
+BigInteger BigInteger::operator+(std::uint64_t other) const&
 {
 	return *this + BigInteger(other);
 }
 
-BigInteger BigInteger::operator-(const BigInteger& other) const
+BigInteger BigInteger::operator+(std::uint64_t other) &&
+{
+	return std::move(*this += other);
+}
+
+BigInteger BigInteger::operator-(const BigInteger& other) const&
 {
 	Digits temp;
 	bool negative = false;
@@ -246,477 +336,801 @@ BigInteger BigInteger::operator-(const BigInteger& other) const
 	return result;
 }
 
-BigInteger BigInteger::operator-(std::int32_t other) const
+BigInteger BigInteger::operator-(const BigInteger& other) &&
 {
-	return *this - BigInteger(other);
+	return std::move(*this -= other);
 }
 
-BigInteger BigInteger::operator-(std::uint32_t other) const
+BigInteger BigInteger::operator-(BigInteger&& other) const&
 {
-	return *this - BigInteger(other);
+	// a - b == -(b - a)
+	return -std::move(other -= *this);
 }
 
-BigInteger BigInteger::operator-(std::int64_t other) const
+BigInteger BigInteger::operator-(BigInteger&& other) &&
 {
-	return *this - BigInteger(other);
+	if (other.m_digits.capacity() > m_digits.capacity())
+	{
+		return -std::move(other -= *this);
+	}
+
+	return std::move(*this -= other);
 }
 
-BigInteger BigInteger::operator-(std::uint64_t other) const
+BigInteger BigInteger::operator-(std::int32_t other) const&
 {
 	return *this - BigInteger(other);
 }
 
-BigInteger BigInteger::operator*(const BigInteger& other) const
+BigInteger BigInteger::operator-(std::int32_t other) &&
 {
-	Digits temp;
-
-	Multiply(m_digits, other.m_digits, temp);
-
-	BigInteger result = BigInteger(std::move(temp), m_isNegative != other.m_isNegative);
-	result.Normalize();
+	return std::move(*this -= other);
+}
 
-	return result;
+BigInteger BigInteger::operator-(std::uint32_t other) const&
+{
+	return *this - BigInteger(other);
 }
 
-BigInteger BigInteger::operator*(std::int32_t other) const
+BigInteger BigInteger::operator-(std::uint32_t other) &&
 {
-	return *this * BigInteger(other);
+	return std::move(*this -= other);
 }
 
-BigInteger BigInteger::operator*(std::uint32_t other) const
+BigInteger BigInteger::operator-(std::int64_t other) const&
 {
-	return *this * BigInteger(other);
+	return *this - BigInteger(other);
 }
 
-BigInteger BigInteger::operator*(std::int64_t other) const
+BigInteger BigInteger::operator-(std::int64_t other) &&
 {
-	return *this * BigInteger(other);
+	return std::move(*this -= other);
 }
 
-BigInteger BigInteger::operator*(std::uint64_t other) const
+BigInteger BigInteger::operator-(std::uint64_t other) const&
 {
-	return *this * BigInteger(other);
+	return *this - BigInteger(other);
 }
 
-BigInteger BigInteger::operator/(const BigInteger& other) const
+BigInteger BigInteger::operator-(std::uint64_t other) &&
 {
-	Digits quotient;
-	Digits remain;
+	return std::move(*this -= other);
+}
 
-	Divide(m_digits, other.m_digits, quotient, remain);
+BigInteger BigInteger::operator*(const BigInteger& other) const&
+{
+	Digits temp;
 
-	BigInteger result = BigInteger(std::move(quotient), m_isNegative != other.m_isNegative);
-	result.Normalize();
+	Multiply(m_digits, other.m_digits, temp);
 
-	//  ū  
-	if (m_isNegative != other.m_isNegative && !(remain.size() == 1 && remain[0] == 0))
-	{
-		result -= 1;
-	}
+	BigInteger result = BigInteger(std::move(temp), m_isNegative != other.m_isNegative);
 	result.Normalize();
 
 	return result;
 }
 
-BigInteger BigInteger::operator/(std::int32_t other) const
+BigInteger BigInteger::operator*(const BigInteger& other) &&
 {
-	return *this / BigInteger(other);
+	return std::move(*this *= other);
 }
 
-BigInteger BigInteger::operator/(std::uint32_t other) const
+BigInteger BigInteger::operator*(BigInteger&& other) const&
 {
-	return *this / BigInteger(other);
+	return std::move(other *= *this);
 }
 
-BigInteger BigInteger::operator/(std::int64_t other) const
+BigInteger BigInteger::operator*(BigInteger&& other) &&
 {
-	return *this / BigInteger(other);
-}
+	if (other.m_digits.capacity() > m_digits.capacity())
+	{
+		return std::move(other *= *this);
+	}
 
-BigInteger BigInteger::operator/(std::uint64_t other) const
-{
-	return *this / BigInteger(other);
+	return std::move(*this *= other);
 }
 
-BigInteger BigInteger::operator%(const BigInteger& other) const
+BigInteger BigInteger::operator*(std::int32_t other) const&
 {
-	Digits quotient;
-	Digits remain;
-
-	Divide(m_digits, other.m_digits, quotient, remain);
-
-	BigInteger result = BigInteger(std::move(remain), m_isNegative != other.m_isNegative);
-	result.Normalize();
-
-	return result;
+	return *this * BigInteger(other);
 }
 
-BigInteger BigInteger::operator%(std::int32_t other) const
+BigInteger BigInteger::operator*(std::int32_t other) &&
 {
-	return *this % BigInteger(other);
+	return std::move(*this *= other);
 }
 
-BigInteger BigInteger::operator%(std::uint32_t other) const
+BigInteger BigInteger::operator*(std::uint32_t other) const&
 {
-	return *this % BigInteger(other);
+	return *this * BigInteger(other);
 }
 
-BigInteger BigInteger::operator%(std::int64_t other) const
+BigInteger BigInteger::operator*(std::uint32_t other) &&
 {
-	return *this % BigInteger(other);
+	return std::move(*this *= other);
 }
 
-BigInteger BigInteger::operator%(std::uint64_t other) const
+BigInteger BigInteger::operator*(std::int64_t other) const&
 {
-	return *this % BigInteger(other);
+	return *this * BigInteger(other);
 }
 
-BigInteger& BigInteger::operator+=(const BigInteger& other)
+BigInteger BigInteger::operator*(std::int64_t other) &&
 {
-	*this = *this + other;
-	return *this;
+	return std::move(*this *= other);
 }
 
-BigInteger& BigInteger::operator+=(std::int32_t other)
+BigInteger BigInteger::operator*(std::uint64_t other) const&
 {
-	*this = *this + other;
-	return *this;
+	return *this * BigInteger(other);
 }
 
-BigInteger& BigInteger::operator+=(std::uint32_t other)
+BigInteger BigInteger::operator*(std::uint64_t other) &&
 {
-	*this = *this + other;
-	return *this;
+	return std::move(*this *= other);
 }
 
-BigInteger& BigInteger::operator+=(std::int64_t other)
+BigInteger BigInteger::operator/(const BigInteger& other) const&
 {
-	*this = *this + other;
-	return *this;
-}
+	BigInteger result{ Digits(), false };
 
-BigInteger& BigInteger::operator+=(std::uint64_t other)
-{
-	*this = *this + other;
-	return *this;
-}
+	result.AssignQuotient(*this, other);
 
-BigInteger& BigInteger::operator-=(const BigInteger& other)
-{
-	*this = *this - other;
-	return *this;
+	return result;
 }
 
-BigInteger& BigInteger::operator-=(std::int32_t other)
+BigInteger BigInteger::operator/(const BigInteger& other) &&
 {
-	*this = *this - other;
-	return *this;
+	return std::move(*this /= other);
 }
 
-BigInteger& BigInteger::operator-=(std::uint32_t other)
+BigInteger BigInteger::operator/(std::int32_t other) const&
 {
-	*this = *this - other;
-	return *this;
-}
+	BigInteger result{ Digits(), false };
 
-BigInteger& BigInteger::operator-=(std::int64_t other)
-{
-	*this = *this - other;
-	return *this;
-}
+	result.AssignQuotientByScalar(*this, ToScalarDigits(static_cast<std::int64_t>(other)));
 
-BigInteger& BigInteger::operator-=(std::uint64_t other)
-{
-	*this = *this - other;
-	return *this;
+	return result;
 }
 
-BigInteger& BigInteger::operator*=(const BigInteger& other)
+BigInteger BigInteger::operator/(std::int32_t other) &&
 {
-	*this = *this * other;
-	return *this;
+	return std::move(*this /= other);
 }
 
-BigInteger& BigInteger::operator*=(std::int32_t other)
+BigInteger BigInteger::operator/(std::uint32_t other) const&
 {
-	*this = *this * other;
-	return *this;
-}
+	BigInteger result{ Digits(), false };
 
-BigInteger& BigInteger::operator*=(std::uint32_t other)
-{
-	*this = *this * other;
-	return *this;
-}
+	result.AssignQuotientByScalar(*this, ToScalarDigits(static_cast<std::uint64_t>(other)));
 
-BigInteger& BigInteger::operator*=(std::int64_t other)
-{
-	*this = *this * other;
-	return *this;
+	return result;
 }
 
-BigInteger& BigInteger::operator*=(std::uint64_t other)
+BigInteger BigInteger::operator/(std::uint32_t other) &&
 {
-	*this = *this * other;
-	return *this;
+	return std::move(*this /= other);
 }
 
-BigInteger& BigInteger::operator/=(const BigInteger& other)
+BigInteger BigInteger::operator/(std::int64_t other) const&
 {
-	*this = *this / other;
-	return *this;
-}
+	BigInteger result{ Digits(), false };
 
-BigInteger& BigInteger::operator/=(std::int32_t other)
-{
-	*this = *this / other;
-	return *this;
-}
+	result.AssignQuotientByScalar(*this, ToScalarDigits(other));
 
-BigInteger& BigInteger::operator/=(std::uint32_t other)
-{
-	*this = *this / other;
-	return *this;
+	return result;
 }
 
-BigInteger& BigInteger::operator/=(std::int64_t other)
+BigInteger BigInteger::operator/(std::int64_t other) &&
 {
-	*this = *this / other;
-	return *this;
+	return std::move(*this /= other);
 }
 
-BigInteger& BigInteger::operator/=(std::uint64_t other)
+BigInteger BigInteger::operator/(std::uint64_t other) const&
 {
-	*this = *this / other;
-	return *this;
-}
+	BigInteger result{ Digits(), false };
 
-BigInteger& BigInteger::operator%=(const BigInteger& other)
-{
-	*this = *this % other;
-	return *this;
-}
+	result.AssignQuotientByScalar(*this, ToScalarDigits(other));
 
-BigInteger& BigInteger::operator%=(std::int32_t other)
-{
-	*this = *this % other;
-	return *this;
+	return result;
 }
 
-BigInteger& BigInteger::operator%=(std::uint32_t other)
+BigInteger BigInteger::operator/(std::uint64_t other) &&
 {
-	*this = *this % other;
-	return *this;
+	return std::move(*this /= other);
 }
 
-BigInteger& BigInteger::operator%=(std::int64_t other)
+BigInteger BigInteger::operator%(const BigInteger& other) const&
 {
-	*this = *this % other;
-	return *this;
+	BigInteger result{ Digits(), false };
+
+	result.AssignRemainder(*this, other);
+
+	return result;
 }
 
-BigInteger& BigInteger::operator%=(std::uint64_t other)
+BigInteger BigInteger::operator%(const BigInteger& other) &&
 {
-	*this = *this % other;
-	return *this;
+	return std::move(*this %= other);
 }
 
-BigInteger BigInteger::operator-() const
+BigInteger BigInteger::operator%(std::int32_t other) const&
 {
-	BigInteger i{ m_digits, !m_isNegative };
+	BigInteger result{ Digits(), false };
 
-	i.Normalize();
+	result.AssignRemainderByScalar(*this, ToScalarDigits(static_cast<std::int64_t>(other)));
 
-	return i;
+	return result;
 }
 
-bool BigInteger::operator<(const BigInteger& other) const
+BigInteger BigInteger::operator%(std::int32_t other) &&
 {
-	if (m_isNegative != other.m_isNegative)
-	{
-		return m_isNegative;
-	}
+	return std::move(*this %= other);
+}
 
-	const size_t selfSize = m_digits.size();
-	const size_t otherSize = other.m_digits.size();
+BigInteger BigInteger::operator%(std::uint32_t other) const&
+{
+	BigInteger result{ Digits(), false };
 
-	if (selfSize != otherSize)
-	{
-		return m_isNegative ? (selfSize > otherSize) : (selfSize < otherSize);
-	}
-	
-	for (long long i = static_cast<long long>(selfSize) - 1; i >= 0; --i)
-	{
-		if (m_digits[i] != other.m_digits[i])
-		{
-			return m_isNegative ? m_digits[i] > other.m_digits[i] : m_digits[i] < other.m_digits[i];
-		}
-	}
+	result.AssignRemainderByScalar(*this, ToScalarDigits(static_cast<std::uint64_t>(other)));
 
-	return false;
+	return result;
 }
 
-bool BigInteger::operator<(std::int32_t other) const
+BigInteger BigInteger::operator%(std::uint32_t other) &&
 {
-	return *this < BigInteger(other);
+	return std::move(*this %= other);
 }
 
-bool BigInteger::operator<(std::uint32_t other) const
+BigInteger BigInteger::operator%(std::int64_t other) const&
 {
-	return *this < BigInteger(other);
-}
+	BigInteger result{ Digits(), false };
 
-bool BigInteger::operator<(std::int64_t other) const
-{
-	return *this < BigInteger(other);
-}
+	result.AssignRemainderByScalar(*this, ToScalarDigits(other));
 
-bool BigInteger::operator<(std::uint64_t other) const
-{
-	return *this < BigInteger(other);
+	return result;
 }
 
-bool BigInteger::operator>(const BigInteger& other) const
+BigInteger BigInteger::operator%(std::int64_t other) &&
 {
-	return !(*this == other) && !(*this < other);
+	return std::move(*this %= other);
 }
 
-bool BigInteger::operator>(std::int32_t other) const
+BigInteger BigInteger::operator%(std::uint64_t other) const&
 {
-	return *this > BigInteger(other);
-}
+	BigInteger result{ Digits(), false };
 
-bool BigInteger::operator>(std::uint32_t other) const
-{
-	return *this > BigInteger(other);
-}
+	result.AssignRemainderByScalar(*this, ToScalarDigits(other));
 
-bool BigInteger::operator>(std::int64_t other) const
-{
-	return *this > BigInteger(other);
+	return result;
 }
 
-bool BigInteger::operator>(std::uint64_t other) const
+BigInteger BigInteger::operator%(std::uint64_t other) &&
 {
-	return *this > BigInteger(other);
+	return std::move(*this %= other);
 }
 
-bool BigInteger::operator<=(const BigInteger& other) const
+void BigInteger::AddSigned(const std::uint32_t* digits, size_t size, bool isNegative)
 {
-	return (*this == other) || (*this < other);
-}
+	Digits& limbs = MutableDigits();
+	const size_t thisSize = limbs.size();
+	const std::span<const std::uint32_t> other{ digits, size };
 
-bool BigInteger::operator<=(std::int32_t other) const
-{
-	return *this <= BigInteger(other);
-}
+	if (m_isNegative == isNegative)
+	{
+		limbs.resize(std::max(thisSize, size) + 1);
+		limbs.resize(BigIntegerLimbs::Add(std::span<const std::uint32_t>(limbs.data(), thisSize), other, limbs));
+	}
+	else if (BigIntegerLimbs::CompareMagnitude(limbs, other) >= 0)
+	{
+		limbs.resize(BigIntegerLimbs::Subtract(limbs, other, limbs));
+	}
+	else
+	{
+		// |this| < |other|, so the result is other - this and takes the sign of other
+		limbs.resize(size);
+		limbs.resize(BigIntegerLimbs::Subtract(other, std::span<const std::uint32_t>(limbs.data(), thisSize), limbs));
 
-bool BigInteger::operator<=(std::uint32_t other) const
-{
-	return *this <= BigInteger(other);
-}
+		m_isNegative = isNegative;
+	}
 
-bool BigInteger::operator<=(std::int64_t other) const
-{
-	return *this <= BigInteger(other);
+	Normalize();
 }
 
-bool BigInteger::operator<=(std::uint64_t other) const
+void BigInteger::AssignQuotient(const BigInteger& dividend, const BigInteger& divisor)
 {
-	return *this <= BigInteger(other);
-}
+	const bool negative = dividend.m_isNegative != divisor.m_isNegative;
 
-bool BigInteger::operator>=(const BigInteger& other) const
-{
-	return (*this == other) || !(*this < other);
-}
+	// detach before reading, dividend or divisor may be *this
+	Digits& quotient = MutableDigits();
+	Digits remain;
 
-bool BigInteger::operator>=(std::int32_t other) const
-{
-	return *this >= BigInteger(other);
-}
+	Divide(dividend.m_digits, divisor.m_digits, quotient, remain);
+	NormalizeDigits(remain);
 
-bool BigInteger::operator>=(std::uint32_t other) const
-{
-	return *this >= BigInteger(other);
-}
+	//  ū  
+	if (negative && !(remain.size() == 1 && remain[0] == 0))
+	{
+		IncrementMagnitude(quotient);
+	}
 
-bool BigInteger::operator>=(std::int64_t other) const
-{
-	return *this >= BigInteger(other);
+	m_isNegative = negative;
+	Normalize();
 }
 
-bool BigInteger::operator>=(std::uint64_t other) const
+void BigInteger::AssignRemainder(const BigInteger& dividend, const BigInteger& divisor)
 {
-	return *this >= BigInteger(other);
+	const bool negative = dividend.m_isNegative != divisor.m_isNegative;
+
+	if (divisor.m_digits.size() <= 2 && !divisor.IsZero())
+	{
+		const std::uint64_t divisorWord = divisor.m_digits.size() == 1 ? divisor.m_digits[0] : divisor.m_digits[0] + divisor.m_digits[1] * BASE;
+
+		AssignWord(MutableDigits(), RemainderByWord(dividend.m_digits, divisorWord));
+	}
+	else
+	{
+		Digits& remain = MutableDigits();
+		Digits quotient;
+
+		Divide(dividend.m_digits, divisor.m_digits, quotient, remain);
+	}
+
+	m_isNegative = negative;
+	Normalize();
 }
 
-bool BigInteger::operator==(const BigInteger& other) const
+void BigInteger::AssignQuotientByScalar(const BigInteger& dividend, const ScalarDigits& divisor)
 {
-	if (m_isNegative != other.m_isNegative)
+	if (divisor.size > 2)
 	{
-		return false;
+		AssignQuotient(dividend, BigInteger(Digits(divisor.digits, divisor.digits + divisor.size), divisor.isNegative));
+
+		return;
 	}
 
-	if (m_digits.size() != other.m_digits.size())
+	const std::uint64_t divisorWord = divisor.digits[0] + divisor.digits[1] * BASE;
+
+	if (divisorWord == 0)
 	{
-		return false;
+		assert(false);
+
+		AssignWord(MutableDigits(), 0);
+		m_isNegative = false;
+
+		return;
 	}
 
-	for (size_t i = 0; i < m_digits.size(); ++i)
+	const bool negative = dividend.m_isNegative != divisor.isNegative;
+	Digits& quotient = MutableDigits();
+	const std::uint64_t remainder = DivideByWord(dividend.m_digits, divisorWord, quotient);
+
+	// floor like operator/
+	if (negative && remainder != 0)
 	{
-		if (m_digits[i] != other.m_digits[i])
-		{
-			return false;
-		}
+		IncrementMagnitude(quotient);
 	}
 
-	return true;
+	m_isNegative = negative;
+	Normalize();
 }
 
-bool BigInteger::operator==(std::int32_t other) const
+void BigInteger::AssignRemainderByScalar(const BigInteger& dividend, const ScalarDigits& divisor)
 {
-	return *this == BigInteger(other);
+	if (divisor.size > 2)
+	{
+		AssignRemainder(dividend, BigInteger(Digits(divisor.digits, divisor.digits + divisor.size), divisor.isNegative));
+
+		return;
+	}
+
+	const std::uint64_t divisorWord = divisor.digits[0] + divisor.digits[1] * BASE;
+
+	if (divisorWord == 0)
+	{
+		assert(false);
+
+		AssignWord(MutableDigits(), 0);
+		m_isNegative = false;
+
+		return;
+	}
+
+	const bool negative = dividend.m_isNegative != divisor.isNegative;
+
+	AssignWord(MutableDigits(), RemainderByWord(dividend.m_digits, divisorWord));
+
+	m_isNegative = negative;
+	Normalize();
 }
 
-bool BigInteger::operator==(std::uint32_t other) const
+DivRemResult BigInteger::DivRem(const BigInteger& dividend, const BigInteger& divisor, DivisionMode mode)
 {
-	return *this == BigInteger(other);
+	DivRemResult result;
+
+	DivRem(dividend, divisor, result.quotient, result.remainder, mode);
+
+	return result;
 }
 
-bool BigInteger::operator==(std::int64_t other) const
+void BigInteger::DivRem(const BigInteger& dividend, const BigInteger& divisor, BigInteger& quotient, BigInteger& remainder, DivisionMode mode)
 {
-	return *this == BigInteger(other);
+	if (divisor.m_digits.size() == 1 && divisor.m_digits[0] == 0)
+	{
+		assert(false);
+
+		quotient = BigInteger();
+		remainder = BigInteger();
+
+		return;
+	}
+
+	Digits quotientDigits;
+	Digits remainDigits;
+
+	Divide(dividend.m_digits, divisor.m_digits, quotientDigits, remainDigits);
+	NormalizeDigits(remainDigits);
+
+	const bool quotientNegative = dividend.m_isNegative != divisor.m_isNegative;
+	const bool inexact = !(remainDigits.size() == 1 && remainDigits[0] == 0);
+	bool remainderNegative = dividend.m_isNegative;
+	bool roundAway = false;
+
+	switch (mode)
+	{
+	case DivisionMode::Floor:
+		roundAway = inexact && quotientNegative;
+		break;
+	case DivisionMode::Euclidean:
+		roundAway = inexact && dividend.m_isNegative;
+		break;
+	default:
+		break;
+	}
+
+	// |q| + 1 and |b| - |r| on the limbs, the remainder takes the sign the mode asks for
+	if (roundAway)
+	{
+		IncrementMagnitude(quotientDigits);
+
+		Digits temp;
+		Subtract(divisor.m_digits, remainDigits, temp);
+
+		remainDigits = std::move(temp);
+		remainderNegative = mode == DivisionMode::Floor ? divisor.m_isNegative : false;
+	}
+
+	quotient = BigInteger(std::move(quotientDigits), quotientNegative);
+	quotient.Normalize();
+
+	remainder = BigInteger(std::move(remainDigits), remainderNegative);
+	remainder.Normalize();
 }
 
-bool BigInteger::operator==(std::uint64_t other) const
+BigInteger BigInteger::DivExact(const BigInteger& dividend, const BigInteger& divisor)
+{
+	if (divisor.m_digits.size() == 1 && divisor.m_digits[0] == 0)
+	{
+		assert(false);
+
+		return BigInteger();
+	}
+
+	Digits quotient;
+
+	DivideExact(dividend.m_digits, divisor.m_digits, quotient);
+
+	BigInteger result = BigInteger(std::move(quotient), dividend.m_isNegative != divisor.m_isNegative);
+	result.Normalize();
+
+	return result;
+}
+
+BigInteger& BigInteger::operator+=(const BigInteger& other)
+{
+	if (this == &other)
+	{
+		Digits& digits = MutableDigits();
+
+		MultiplyByDigit(digits, 2, digits);
+
+		return *this;
+	}
+
+	AddSigned(other.m_digits.data(), other.m_digits.size(), other.m_isNegative);
+	return *this;
+}
+
+BigInteger& BigInteger::operator+=(std::int32_t other)
+{
+	const ScalarDigits scalar = ToScalarDigits(static_cast<std::int64_t>(other));
+
+	AddSigned(scalar.digits, scalar.size, scalar.isNegative);
+	return *this;
+}
+
+BigInteger& BigInteger::operator+=(std::uint32_t other)
+{
+	const ScalarDigits scalar = ToScalarDigits(static_cast<std::uint64_t>(other));
+
+	AddSigned(scalar.digits, scalar.size, scalar.isNegative);
+	return *this;
+}
+
+BigInteger& BigInteger::operator+=(std::int64_t other)
+{
+	const ScalarDigits scalar = ToScalarDigits(other);
+
+	AddSigned(scalar.digits, scalar.size, scalar.isNegative);
+	return *this;
+}
+
+BigInteger& BigInteger::operator+=(std::uint64_t other)
+{
+	const ScalarDigits scalar = ToScalarDigits(other);
+
+	AddSigned(scalar.digits, scalar.size, scalar.isNegative);
+	return *this;
+}
+
+BigInteger& BigInteger::operator-=(const BigInteger& other)
+{
+	if (this == &other)
+	{
+		AssignWord(MutableDigits(), 0);
+		m_isNegative = false;
+
+		return *this;
+	}
+
+	AddSigned(other.m_digits.data(), other.m_digits.size(), !other.m_isNegative);
+	return *this;
+}
+
+BigInteger& BigInteger::operator-=(std::int32_t other)
+{
+	const ScalarDigits scalar = ToScalarDigits(static_cast<std::int64_t>(other));
+
+	AddSigned(scalar.digits, scalar.size, !scalar.isNegative);
+	return *this;
+}
+
+BigInteger& BigInteger::operator-=(std::uint32_t other)
+{
+	const ScalarDigits scalar = ToScalarDigits(static_cast<std::uint64_t>(other));
+
+	AddSigned(scalar.digits, scalar.size, !scalar.isNegative);
+	return *this;
+}
+
+BigInteger& BigInteger::operator-=(std::int64_t other)
+{
+	const ScalarDigits scalar = ToScalarDigits(other);
+
+	AddSigned(scalar.digits, scalar.size, !scalar.isNegative);
+	return *this;
+}
+
+BigInteger& BigInteger::operator-=(std::uint64_t other)
+{
+	const ScalarDigits scalar = ToScalarDigits(other);
+
+	AddSigned(scalar.digits, scalar.size, !scalar.isNegative);
+	return *this;
+}
+
+BigInteger& BigInteger::operator*=(const BigInteger& other)
+{
+	if (this == &other)
+	{
+		*this = *this * other;
+		return *this;
+	}
+
+	MultiplyInPlace(MutableDigits(), other.m_digits.data(), other.m_digits.size());
+
+	m_isNegative = m_isNegative != other.m_isNegative;
+	Normalize();
+
+	return *this;
+}
+
+BigInteger& BigInteger::operator*=(std::int32_t other)
+{
+	const ScalarDigits scalar = ToScalarDigits(static_cast<std::int64_t>(other));
+
+	MultiplyInPlace(MutableDigits(), scalar.digits, scalar.size);
+
+	m_isNegative = m_isNegative != scalar.isNegative;
+	Normalize();
+
+	return *this;
+}
+
+BigInteger& BigInteger::operator*=(std::uint32_t other)
+{
+	const ScalarDigits scalar = ToScalarDigits(static_cast<std::uint64_t>(other));
+
+	MultiplyInPlace(MutableDigits(), scalar.digits, scalar.size);
+
+	m_isNegative = m_isNegative != scalar.isNegative;
+	Normalize();
+
+	return *this;
+}
+
+BigInteger& BigInteger::operator*=(std::int64_t other)
+{
+	const ScalarDigits scalar = ToScalarDigits(other);
+
+	MultiplyInPlace(MutableDigits(), scalar.digits, scalar.size);
+
+	m_isNegative = m_isNegative != scalar.isNegative;
+	Normalize();
+
+	return *this;
+}
+
+BigInteger& BigInteger::operator*=(std::uint64_t other)
+{
+	const ScalarDigits scalar = ToScalarDigits(other);
+
+	MultiplyInPlace(MutableDigits(), scalar.digits, scalar.size);
+
+	m_isNegative = m_isNegative != scalar.isNegative;
+	Normalize();
+
+	return *this;
+}
+
+BigInteger& BigInteger::operator/=(const BigInteger& other)
+{
+	AssignQuotient(*this, other);
+	return *this;
+}
+
+BigInteger& BigInteger::operator/=(std::int32_t other)
+{
+	AssignQuotientByScalar(*this, ToScalarDigits(static_cast<std::int64_t>(other)));
+	return *this;
+}
+
+BigInteger& BigInteger::operator/=(std::uint32_t other)
+{
+	AssignQuotientByScalar(*this, ToScalarDigits(static_cast<std::uint64_t>(other)));
+	return *this;
+}
+
+BigInteger& BigInteger::operator/=(std::int64_t other)
+{
+	AssignQuotientByScalar(*this, ToScalarDigits(other));
+	return *this;
+}
+
+BigInteger& BigInteger::operator/=(std::uint64_t other)
+{
+	AssignQuotientByScalar(*this, ToScalarDigits(other));
+	return *this;
+}
+
+BigInteger& BigInteger::operator%=(const BigInteger& other)
+{
+	AssignRemainder(*this, other);
+	return *this;
+}
+
+BigInteger& BigInteger::operator%=(std::int32_t other)
+{
+	AssignRemainderByScalar(*this, ToScalarDigits(static_cast<std::int64_t>(other)));
+	return *this;
+}
+
+BigInteger& BigInteger::operator%=(std::uint32_t other)
+{
+	AssignRemainderByScalar(*this, ToScalarDigits(static_cast<std::uint64_t>(other)));
+	return *this;
+}
+
+BigInteger& BigInteger::operator%=(std::int64_t other)
+{
+	AssignRemainderByScalar(*this, ToScalarDigits(other));
+	return *this;
+}
+
+BigInteger& BigInteger::operator%=(std::uint64_t other)
+{
+	AssignRemainderByScalar(*this, ToScalarDigits(other));
+	return *this;
+}
+
+BigInteger BigInteger::operator-() const&
+{
+	BigInteger i{ m_digits, !m_isNegative };
+
+	i.Normalize();
+
+	return i;
+}
+
+BigInteger BigInteger::operator-() &&
 {
-	return *this == BigInteger(other);
+	m_isNegative = !m_isNegative;
+	Normalize();
+
+	return std::move(*this);
 }
 
-bool BigInteger::operator!=(const BigInteger& other) const
+std::strong_ordering BigInteger::operator<=>(const BigInteger& other) const
 {
-	return !(*this == other);
+	return Compare(other);
 }
 
-bool BigInteger::operator!=(std::int32_t other) const
+std::strong_ordering BigInteger::operator<=>(std::int32_t other) const
 {
-	return *this != BigInteger(other);
+	const ScalarDigits scalar = ToScalarDigits(static_cast<std::int64_t>(other));
+
+	return CompareSigned(m_digits.data(), m_digits.size(), m_isNegative, scalar.digits, scalar.size, scalar.isNegative);
 }
 
-bool BigInteger::operator!=(std::uint32_t other) const
+std::strong_ordering BigInteger::operator<=>(std::uint32_t other) const
 {
-	return *this != BigInteger(other);
+	const ScalarDigits scalar = ToScalarDigits(static_cast<std::uint64_t>(other));
+
+	return CompareSigned(m_digits.data(), m_digits.size(), m_isNegative, scalar.digits, scalar.size, scalar.isNegative);
 }
 
-bool BigInteger::operator!=(std::int64_t other) const
+std::strong_ordering BigInteger::operator<=>(std::int64_t other) const
 {
-	return *this != BigInteger(other);
+	const ScalarDigits scalar = ToScalarDigits(other);
+
+	return CompareSigned(m_digits.data(), m_digits.size(), m_isNegative, scalar.digits, scalar.size, scalar.isNegative);
 }
 
-bool BigInteger::operator!=(std::uint64_t other) const
+std::strong_ordering BigInteger::operator<=>(std::uint64_t other) const
 {
-	return *this != BigInteger(other);
+	const ScalarDigits scalar = ToScalarDigits(other);
+
+	return CompareSigned(m_digits.data(), m_digits.size(), m_isNegative, scalar.digits, scalar.size, scalar.isNegative);
+}
+
+bool BigInteger::operator==(const BigInteger& other) const
+{
+	if (m_isNegative != other.m_isNegative)
+	{
+		return false;
+	}
+
+	if (m_digits.size() != other.m_digits.size())
+	{
+		return false;
+	}
+
+	return std::equal(m_digits.begin(), m_digits.end(), other.m_digits.begin());
+}
+
+bool BigInteger::operator==(std::int32_t other) const
+{
+	return (*this <=> other) == 0;
+}
+
+bool BigInteger::operator==(std::uint32_t other) const
+{
+	return (*this <=> other) == 0;
+}
+
+bool BigInteger::operator==(std::int64_t other) const
+{
+	return (*this <=> other) == 0;
+}
+
+bool BigInteger::operator==(std::uint64_t other) const
+{
+	return (*this <=> other) == 0;
+}
+
+std::strong_ordering BigInteger::Compare(const BigInteger& other) const
+{
+	return CompareSigned(m_digits.data(), m_digits.size(), m_isNegative,
+		other.m_digits.data(), other.m_digits.size(), other.m_isNegative);
 }
 
 bool BigInteger::IsValid(const std::string& number)
@@ -736,336 +1150,796 @@ bool BigInteger::IsValid(const std::string& number)
 		++position;
 	}
 
-	if (position == length)
+	if (position == length)
+	{
+		assert(false);
+
+		return false;
+	}
+
+	while (position < length)
+	{
+		if (number[position] < '0' || number[position] > '9')
+		{
+			assert(false);
+
+			return false;
+		}
+
+		++position;
+	}
+
+	return true;
+}
+
+bool BigInteger::IsZero() const
+{
+	return m_digits.size() == 1 && m_digits[0] == 0;
+}
+
+void BigInteger::Normalize()
+{
+	BIGINTEGER_PROFILE_KERNEL(Normalize, m_digits.size());
+
+	// reads go through the const storage, so a normalized shared buffer is not detached
+	const DigitStorage& digits = m_digits;
+	size_t size = digits.size();
+
+	while (size > 1 && digits[size - 1] == 0)
+	{
+		--size;
+	}
+
+	if (size != digits.size())
+	{
+		m_digits.resize(size);
+	}
+
+	if (size == 1 && digits[0] == 0)
+	{
+		m_isNegative = false;
+	}
+}
+
+BigInteger::Digits& BigInteger::MutableDigits()
+{
+#if defined(BIGINTEGER_SHARED_STORAGE)
+	return m_digits.Mutate();
+#else
+	return m_digits;
+#endif
+}
+
+std::string BigInteger::ToString() const
+{
+	// a moved-from object has no limbs and prints as nothing
+	if (m_digits.empty())
+	{
+		return {};
+	}
+
+	return GetView().ToString();
+}
+
+std::string BigInteger::ToStringParallel(size_t threadCount) const
+{
+	if (m_digits.empty())
+	{
+		return {};
+	}
+
+	return GetView().ToStringParallel(threadCount);
+}
+
+std::vector<std::uint8_t> BigInteger::ToBytes(WordOrder order, size_t wordSize, ByteOrder endian) const
+{
+	if (wordSize == 0)
+	{
+		assert(false);
+
+		return {};
+	}
+
+	const std::vector<std::uint32_t> words = BigIntegerRadix::ToWords(std::span<const std::uint32_t>(m_digits.data(), m_digits.size()));
+
+	size_t significantBytes = words.size() * 4;
+
+	while (significantBytes > 0 && (words[(significantBytes - 1) / 4] >> ((significantBytes - 1) % 4 * 8) & 0xFF) == 0)
+	{
+		--significantBytes;
+	}
+
+	const size_t wordCount = (significantBytes + wordSize - 1) / wordSize;
+	std::vector<std::uint8_t> bytes(wordCount * wordSize, 0);
+
+	for (size_t i = 0; i < significantBytes; ++i)
+	{
+		bytes[GetByteOffset(i, wordCount, order, wordSize, endian)] = static_cast<std::uint8_t>(words[i / 4] >> (i % 4 * 8));
+	}
+
+	return bytes;
+}
+
+std::string BigInteger::ToHex() const
+{
+	static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+	const std::vector<std::uint32_t> words = BigIntegerRadix::ToWords(std::span<const std::uint32_t>(m_digits.data(), m_digits.size()));
+
+	std::string text = m_isNegative ? "-" : "";
+	const std::uint32_t top = words.back();
+
+	// the top word without leading zeros, every word below as exactly 8 digits
+	for (int shift = std::max(static_cast<int>(std::bit_width(top)) - 1, 0) / 4 * 4; shift >= 0; shift -= 4)
+	{
+		text += HEX_DIGITS[top >> shift & 0xF];
+	}
+
+	for (size_t i = words.size() - 1; i > 0; --i)
+	{
+		for (int shift = 28; shift >= 0; shift -= 4)
+		{
+			text += HEX_DIGITS[words[i - 1] >> shift & 0xF];
+		}
+	}
+
+	return text;
+}
+
+BigIntegerView BigInteger::GetView() const
+{
+	if (m_digits.empty())
+	{
+		return BigIntegerView();
+	}
+
+	return BigIntegerView(std::span<const std::uint32_t>(m_digits.data(), m_digits.size()), m_isNegative);
+}
+
+BigInteger BigInteger::FromBytes(std::span<const std::uint8_t> bytes, bool isNegative, WordOrder order, size_t wordSize, ByteOrder endian)
+{
+	if (wordSize == 0 || bytes.size() % wordSize != 0)
+	{
+		assert(false);
+
+		return BigInteger();
+	}
+
+	const size_t wordCount = bytes.size() / wordSize;
+	std::vector<std::uint32_t> words((bytes.size() + 3) / 4, 0);
+
+	for (size_t i = 0; i < bytes.size(); ++i)
+	{
+		words[i / 4] |= static_cast<std::uint32_t>(bytes[GetByteOffset(i, wordCount, order, wordSize, endian)]) << (i % 4 * 8);
+	}
+
+	return BigIntegerRadix::FromWords(words, isNegative);
+}
+
+BigInteger BigInteger::FromHex(const std::string& number)
+{
+	const bool isNegative = !number.empty() && number[0] == '-';
+	size_t start = isNegative ? 1 : 0;
+
+	if (number.compare(start, 2, "0x") == 0 || number.compare(start, 2, "0X") == 0)
+	{
+		start += 2;
+	}
+
+	if (start == number.size())
 	{
 		assert(false);
 
-		return false;
+		return BigInteger();
 	}
 
-	while (position < length)
+	std::vector<std::uint32_t> words((number.size() - start + 7) / 8, 0);
+
+	// 8 hex digits per word from the right
+	for (size_t i = number.size(), position = 0; i > start; --i, ++position)
 	{
-		if (number[position] < '0' || number[position] > '9')
+		const char c = number[i - 1];
+		std::uint32_t value = 0;
+
+		if (c >= '0' && c <= '9')
+		{
+			value = c - '0';
+		}
+		else if (c >= 'a' && c <= 'f')
+		{
+			value = c - 'a' + 10;
+		}
+		else if (c >= 'A' && c <= 'F')
+		{
+			value = c - 'A' + 10;
+		}
+		else
 		{
 			assert(false);
 
-			return false;
+			return BigInteger();
 		}
 
-		++position;
+		words[position / 8] |= value << (position % 8 * 4);
 	}
 
-	return true;
+	return BigIntegerRadix::FromWords(words, isNegative);
 }
 
-void BigInteger::Normalize()
+BigInteger BigInteger::ParseParallel(const std::string& number, size_t threadCount)
 {
-	for (int i = static_cast<int>(m_digits.size()) - 1; i >= 0; --i)
+	const bool isNegative = !number.empty() && number[0] == '-';
+	const size_t start = isNegative ? 1 : 0;
+	const size_t limbCount = (number.size() - start + 8) / 9;
+
+	threadCount = BigIntegerParallel::GetThreadCount(threadCount, limbCount, BigIntegerTuning::GetThresholds().parallelTextLimbs);
+
+	if (threadCount == 1)
+	{
+		return BigInteger(number);
+	}
+
+	BIGINTEGER_PROFILE_KERNEL(Parse, limbCount);
+
+	Digits digits(limbCount);
+	// one flag per chunk, merged after the join
+	std::vector<char> isValid(threadCount, 1);
+
+	BigIntegerParallel::ForEachChunk(limbCount, threadCount, [&number, &digits, &isValid, start](size_t chunk, size_t begin, size_t end)
 	{
-		if (m_digits[i] == 0)
+		const std::string_view text{ number };
+		bool isChunkValid = true;
+
+		for (size_t limb = begin; limb < end; ++limb)
 		{
-			if (i == 0)
-			{
-				m_isNegative = false;
-			}
-			else
+			// limb i is the 9 characters ending 9 * i from the right, the top one may be shorter
+			const size_t last = text.size() - limb * 9;
+			const size_t first = last - start > 9 ? last - 9 : start;
+			std::uint32_t digit = 0;
+
+			for (size_t i = first; i < last; ++i)
 			{
-				m_digits.pop_back();
+				const std::uint32_t value = static_cast<std::uint32_t>(text[i] - '0');
+
+				isChunkValid = isChunkValid && value <= 9;
+				digit = digit * 10 + value;
 			}
+
+			digits[limb] = digit;
 		}
-		else
-		{
-			break;
-		}
+
+		isValid[chunk] = isChunkValid ? 1 : 0;
+	});
+
+	if (std::find(isValid.begin(), isValid.end(), 0) != isValid.end())
+	{
+		assert(false);
+
+		return BigInteger();
 	}
+
+	BigInteger result{ std::move(digits), isNegative };
+
+	result.Normalize();
+
+	return result;
 }
 
-std::string BigInteger::ToString() const
+BigInteger BigInteger::MulPow10(size_t exponent) const
 {
-	std::ostringstream oss;
-
-	if (m_isNegative)
+	if (IsZero())
 	{
-		oss << '-';
+		return *this;
 	}
 
-	if (m_digits.size() == 1 && m_digits[0] == 0)
+	const size_t limbShift = exponent / 9;
+	const std::uint64_t multiplier = POW_TEN[exponent % 9];
+	const size_t size = m_digits.size();
+
+	Digits digits;
+	digits.reserve(limbShift + size + 1);
+	digits.resize(limbShift + size, 0);
+
+	if (multiplier == 1)
 	{
-		oss << '0';
+		std::copy(m_digits.begin(), m_digits.end(), digits.begin() + limbShift);
 	}
 	else
 	{
-		int size = static_cast<int>(m_digits.size());
-		for (int i = size - 1; i >= 0; --i)
+		std::uint64_t carry = 0;
+
+		for (size_t i = 0; i < size; ++i)
 		{
-			if (i == size - 1)
-			{
-				oss << m_digits[i];
-			}
-			else
-			{
-				oss << ZERO_PAD_STRINGS[GetDigitCount(m_digits[i]) - 1];
-				oss << m_digits[i];
-			}
+			const std::uint64_t product = m_digits[i] * multiplier + carry;
+
+			carry = product / BASE;
+
+			digits[limbShift + i] = static_cast<std::uint32_t>(product % BASE);
+		}
+
+		if (carry > 0)
+		{
+			digits.push_back(static_cast<std::uint32_t>(carry));
 		}
 	}
 
-	return oss.str();
+	return BigInteger(std::move(digits), m_isNegative);
 }
 
-BigInteger BigInteger::Abs() const
+BigInteger BigInteger::DivPow10(size_t exponent) const
 {
-	return BigInteger(m_digits, false);
-}
+	const size_t limbShift = exponent / 9;
 
-void BigInteger::Add(const Digits& a, const Digits& b, Digits& out)
-{
-	out.clear();
+	if (limbShift >= m_digits.size())
+	{
+		return BigInteger();
+	}
 
-	const size_t aSize = a.size();
-	const size_t bSize = b.size();
-	const size_t size = std::max(aSize, bSize);
+	const size_t size = m_digits.size() - limbShift;
+	const std::uint32_t* source = m_digits.data() + limbShift;
 
-	out.resize(size + 1, 0);
+	Digits digits(size);
 
-	for (size_t i = 0; i < size; ++i)
+	switch (exponent % 9)
 	{
-		if (i < aSize)
-		{
-			out[i] += a[i];
-		}
+	case 0:
+		std::copy(source, source + size, digits.begin());
+		break;
+	case 1:
+		ShiftDigitsDown<10>(source, size, digits.data());
+		break;
+	case 2:
+		ShiftDigitsDown<100>(source, size, digits.data());
+		break;
+	case 3:
+		ShiftDigitsDown<1000>(source, size, digits.data());
+		break;
+	case 4:
+		ShiftDigitsDown<10000>(source, size, digits.data());
+		break;
+	case 5:
+		ShiftDigitsDown<100000>(source, size, digits.data());
+		break;
+	case 6:
+		ShiftDigitsDown<1000000>(source, size, digits.data());
+		break;
+	case 7:
+		ShiftDigitsDown<10000000>(source, size, digits.data());
+		break;
+	default:
+		ShiftDigitsDown<100000000>(source, size, digits.data());
+		break;
+	}
 
-		if (i < bSize)
-		{
-			out[i] += b[i];
-		}
+	BigInteger result = BigInteger(std::move(digits), m_isNegative);
+	result.Normalize();
 
-		out[i + 1] += out[i] / BASE;
-		out[i] %= BASE;
-	}
+	return result;
 }
 
-void BigInteger::Subtract(const Digits& bigger, const Digits& smaller, Digits& out)
+BigInteger BigInteger::ModPow10(size_t exponent) const
 {
-	out.clear();
+	const size_t limbShift = exponent / 9;
 
-	const size_t biggerSize = bigger.size();
-	const size_t smallerSize = smaller.size();
+	if (limbShift >= m_digits.size())
+	{
+		return *this;
+	}
 
-	out.resize(biggerSize, 0);
-	int borrow = 0;
+	const std::uint64_t divisor = POW_TEN[exponent % 9];
 
-	for (size_t i = 0; i < biggerSize; ++i)
-	{
-		std::int64_t diff = static_cast<std::int64_t>(bigger[i]) -
-			(i < smallerSize ? static_cast<std::int64_t>(smaller[i]) : 0) - borrow;
+	Digits digits;
+	digits.reserve(limbShift + 1);
+	digits.assign(m_digits.begin(), m_digits.begin() + limbShift);
 
-		if (diff < 0)
-		{
-			diff += BASE;
-			borrow = 1;
-		}
-		else
-		{
-			borrow = 0;
-		}
+	if (divisor > 1)
+	{
+		digits.push_back(static_cast<std::uint32_t>(m_digits[limbShift] % divisor));
+	}
 
-		out[i] = static_cast<std::uint32_t>(diff);
+	if (digits.empty())
+	{
+		return BigInteger();
 	}
+
+	BigInteger result = BigInteger(std::move(digits), m_isNegative);
+	result.Normalize();
+
+	return result;
 }
 
-void BigInteger::Multiply(const Digits& a, const Digits& b, Digits& out)
+void BigInteger::ShiftLimbs(std::ptrdiff_t count)
 {
-	// todo : FFT(Ǵ NTT) 
+	if (count == 0 || IsZero())
+	{
+		return;
+	}
 
-	out.clear();
+	const size_t size = m_digits.size();
 
-	const size_t aSize = a.size();
-	const size_t bSize = b.size();
+	if (count > 0)
+	{
+		const size_t shift = static_cast<size_t>(count);
 
-	out.resize(aSize + bSize, 0);
+		m_digits.resize(size + shift);
 
-	for (size_t i = 0; i < aSize; ++i)
-	{
-		std::uint64_t carry = 0;
+		std::copy_backward(m_digits.begin(), m_digits.begin() + size, m_digits.end());
+		std::fill(m_digits.begin(), m_digits.begin() + shift, 0);
 
-		for (size_t j = 0; j < bSize; ++j)
-		{
-			std::uint64_t result = static_cast<std::uint64_t>(a[i]) * b[j] + out[i + j] + carry;
+		return;
+	}
 
-			carry = result / BASE;
+	const size_t shift = static_cast<size_t>(-count);
 
-			out[i + j] = static_cast<std::uint32_t>(result % BASE);
-		}
+	if (shift >= size)
+	{
+		m_digits.assign(1, 0);
+		m_isNegative = false;
 
-		out[i + bSize] += static_cast<std::uint32_t>(carry);
+		return;
 	}
+
+	m_digits.erase(m_digits.begin(), m_digits.begin() + shift);
+	Normalize();
 }
 
-void BigInteger::MultiplyByDigit(const Digits& a, std::uint32_t digit, Digits& out)
+BigInteger BigInteger::Abs() const&
 {
-	// todo : FFT(Ǵ NTT) 
+	return BigInteger(m_digits, false);
+}
+
+BigInteger BigInteger::Abs() &&
+{
+	m_isNegative = false;
+
+	return std::move(*this);
+}
+
+size_t BigInteger::Hash() const
+{
+	// xxHash64 style rounds over two limbs per 64-bit word, two independent lanes
+	constexpr std::uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+	constexpr std::uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+
+	const size_t size = m_digits.size();
+	const std::uint32_t* digits = m_digits.data();
 
-	out.clear();
+	std::uint64_t lane0 = PRIME1 + PRIME2;
+	std::uint64_t lane1 = PRIME2;
+	size_t i = 0;
 
-	if (digit == 0)
+	for (; i + 4 <= size; i += 4)
 	{
-		out.push_back(0);
+		const std::uint64_t word0 = digits[i] | (static_cast<std::uint64_t>(digits[i + 1]) << 32);
+		const std::uint64_t word1 = digits[i + 2] | (static_cast<std::uint64_t>(digits[i + 3]) << 32);
 
-		return;
+		lane0 = std::rotl(lane0 + word0 * PRIME2, 31) * PRIME1;
+		lane1 = std::rotl(lane1 + word1 * PRIME2, 31) * PRIME1;
 	}
 
-	std::uint64_t carry = 0;
+	std::uint64_t hash = std::rotl(lane0, 1) + std::rotl(lane1, 7);
 
-	for (size_t i = 0; i < a.size(); ++i)
+	for (; i < size; ++i)
 	{
-		std::uint64_t result = static_cast<std::uint64_t>(a[i]) * digit + carry;
-		
-		carry = result / BASE;
-
-		out.push_back(static_cast<std::uint32_t>(result % BASE));
+		hash = std::rotl(hash ^ (digits[i] * PRIME1), 23) * PRIME2;
 	}
 
-	if (carry > 0)
+	hash ^= (static_cast<std::uint64_t>(size) << 1) | (m_isNegative ? 1 : 0);
+
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33;
+	hash *= 0xC4CEB9FE1A85EC53ULL;
+	hash ^= hash >> 33;
+
+	return static_cast<size_t>(hash);
+}
+
+void BigInteger::Add(const Digits& a, const Digits& b, Digits& out)
+{
+	out.resize(std::max(a.size(), b.size()) + 1);
+	out.resize(BigIntegerLimbs::Add(a, b, out));
+}
+
+void BigInteger::Subtract(const Digits& bigger, const Digits& smaller, Digits& out)
+{
+	out.resize(bigger.size());
+	out.resize(BigIntegerLimbs::Subtract(bigger, smaller, out));
+}
+
+void BigInteger::Multiply(const Digits& a, const Digits& b, Digits& out)
+{
+	out.resize(a.size() + b.size());
+	out.resize(BigIntegerLimbs::Multiply(a, b, out));
+}
+
+void BigInteger::MultiplyByDigit(const Digits& a, std::uint32_t digit, Digits& out)
+{
+	// todo : FFT(Ǵ NTT) 
+
+	// out may alias a, so take the size before growing out
+	const size_t size = a.size();
+
+	out.resize(size + 1);
+	out.resize(BigIntegerLimbs::MultiplyByDigit(std::span<const std::uint32_t>(a.data(), size), digit, out));
+}
+
+void BigInteger::MultiplyInPlace(Digits& a, const std::uint32_t* b, size_t bSize)
+{
+	const size_t aSize = a.size();
+
+	// the in-place kernel is schoolbook, past the crossover the faster tiers are worth the buffer
+	if (std::min(aSize, bSize) >= BigIntegerTuning::GetThresholds().karatsubaLimbs)
 	{
-		out.push_back(static_cast<std::uint32_t>(carry));
+		Digits product(aSize + bSize);
+
+		product.resize(BigIntegerLimbs::Multiply(a, std::span<const std::uint32_t>(b, bSize), product));
+		a.swap(product);
+
+		return;
 	}
+
+	a.resize(aSize + bSize);
+	a.resize(BigIntegerLimbs::MultiplyInPlace(a, aSize, std::span<const std::uint32_t>(b, bSize)));
 }
 
 void BigInteger::Divide(const Digits& dividend, const Digits& divisor, Digits& quotient, Digits& remain)
 {
 	// todo : Knuth Algorithm D  
 
-	quotient.clear();
-	remain.clear();
-
 	if (divisor.size() == 1 && divisor[0] == 0)
 	{
 		assert(false);
 
+		quotient.clear();
+		remain.clear();
 		quotient.push_back(0);
 
 		return;
 	}
 
-	int diff = CompareMagnitude(dividend, divisor);
-
-	if (diff == -1)
+	// DivideByWord works in place, so either output may alias an input here
+	if (divisor.size() <= 2)
 	{
-		quotient.push_back(0);
-		remain = dividend;
+		BIGINTEGER_PROFILE_KERNEL(Divide, dividend.size());
+
+		const std::uint64_t divisorWord = divisor.size() == 1 ? divisor[0] : divisor[0] + divisor[1] * BASE;
+
+		AssignWord(remain, DivideByWord(dividend, divisorWord, quotient));
 
 		return;
 	}
 
-	if (diff == 0)
+	if (&quotient == &dividend || &quotient == &divisor || &remain == &dividend || &remain == &divisor)
 	{
-		quotient.push_back(1);
-		remain.push_back(0);
+		const Digits dividendCopy = dividend;
+		const Digits divisorCopy = divisor;
+
+		Divide(dividendCopy, divisorCopy, quotient, remain);
 
 		return;
 	}
 
-	for (int i = static_cast<int>(dividend.size()) - 1; i >= 0; --i)
-	{
-		remain.insert(remain.begin(), dividend[i]);
-		NormalizeDigits(remain);
+	size_t quotientSize = 0;
+	size_t remainSize = 0;
+
+	quotient.resize(dividend.size());
+	remain.resize(divisor.size());
+
+	BigIntegerLimbs::Divide(dividend, divisor, quotient, remain, quotientSize, remainSize);
+
+	quotient.resize(quotientSize);
+	remain.resize(remainSize);
+}
+
+void BigInteger::DivideExact(const Digits& dividend, const Digits& divisor, Digits& quotient)
+{
+	Digits remain = dividend;
+	Digits divisorDigits = divisor;
 
-		if (CompareMagnitude(remain, divisor) < 0)
+	// the low divisor limb has to be invertible mod BASE, so strip the factors 2 and 5 it shares with BASE
+	while (remain.size() >= divisorDigits.size())
+	{
+		if (divisorDigits[0] == 0)
 		{
-			quotient.insert(quotient.begin(), 0);
+			remain.erase(remain.begin());
+			divisorDigits.erase(divisorDigits.begin());
 
 			continue;
 		}
 
-		std::uint32_t left = 1;
-		std::uint32_t right = BASE - 1;
-		std::uint32_t qDigit = 0;
+		std::uint32_t low = divisorDigits[0];
+		std::uint32_t factor = 1;
+
+		for (int i = 0; i < 9 && low % 2 == 0; ++i)
+		{
+			low /= 2;
+			factor *= 2;
+		}
+
+		for (int i = 0; i < 9 && low % 5 == 0; ++i)
+		{
+			low /= 5;
+			factor *= 5;
+		}
+
+		if (factor == 1)
+		{
+			break;
+		}
+
+		DivideByWord(remain, factor, remain);
+		DivideByWord(divisorDigits, factor, divisorDigits);
+	}
+
+	const size_t divisorSize = divisorDigits.size();
+
+	if (remain.size() < divisorSize)
+	{
+		quotient.assign(1, 0);
+
+		return;
+	}
+
+	// the quotient is below BASE^quotientSize, so it is dividend / divisor mod BASE^quotientSize
+	// and the limbs above that are never read
+	const size_t quotientSize = remain.size() - divisorSize + 1;
+	const std::uint64_t inverse = InverseModBase(divisorDigits[0]);
+
+	remain.resize(quotientSize);
+	quotient.resize(quotientSize);
+
+	for (size_t i = 0; i < quotientSize; ++i)
+	{
+		const std::uint32_t qDigit = static_cast<std::uint32_t>(remain[i] * inverse % BASE);
+
+		quotient[i] = qDigit;
 
-		while (left <= right)
+		const size_t end = std::min(quotientSize, i + divisorSize);
+		std::uint64_t carry = 0;
+
+		for (size_t j = i; j < end; ++j)
 		{
-			std::uint32_t mid = left + (right - left) / 2;
+			const std::uint64_t product = static_cast<std::uint64_t>(qDigit) * divisorDigits[j - i] + carry;
+			const std::uint32_t low = static_cast<std::uint32_t>(product % BASE);
 
-			Digits temp;
-			MultiplyByDigit(divisor, mid, temp);
+			carry = product / BASE;
 
-			if (CompareMagnitude(temp, remain) <= 0)
+			if (remain[j] < low)
 			{
-				qDigit = mid;
-				left = mid + 1;
+				remain[j] += static_cast<std::uint32_t>(BASE) - low;
+				++carry;
 			}
 			else
 			{
-				right = mid - 1;
+				remain[j] -= low;
 			}
 		}
 
-		Digits multiplyTemp, subtractTemp;
-		MultiplyByDigit(divisor, qDigit, multiplyTemp);
-		Subtract(remain, multiplyTemp, subtractTemp);
+		for (size_t j = end; j < quotientSize && carry > 0; ++j)
+		{
+			const std::uint64_t low = carry % BASE;
 
-		remain = std::move(subtractTemp);
+			carry /= BASE;
 
-		quotient.insert(quotient.begin(), qDigit);
+			if (remain[j] < low)
+			{
+				remain[j] += static_cast<std::uint32_t>(BASE - low);
+				++carry;
+			}
+			else
+			{
+				remain[j] -= static_cast<std::uint32_t>(low);
+			}
+		}
 	}
+
+	NormalizeDigits(quotient);
 }
 
-int BigInteger::CompareMagnitude(const Digits& a, const Digits& b)
+std::uint64_t BigInteger::InverseModBase(std::uint32_t digit)
 {
-	const size_t aSize = a.size();
-	const size_t bSize = b.size();
+	// inverses mod 10, then each Newton step doubles the number of correct decimal digits
+	constexpr std::uint64_t INVERSE_MOD_TEN[10]{ 0, 1, 0, 7, 0, 0, 0, 3, 0, 9 };
 
-	if (aSize != bSize)
-	{
-		return aSize > bSize ? 1 : -1;
-	}
+	const std::uint64_t a = digit;
+	std::uint64_t inverse = INVERSE_MOD_TEN[digit % 10];
 
-	for (long long i = static_cast<long long>(aSize) - 1; i >= 0; --i)
+	for (int i = 0; i < 4; ++i)
 	{
-		if (a[i] != b[i])
-		{
-			return a[i] > b[i] ? 1 : -1;
-		}
+		const std::uint64_t product = a * inverse % BASE;
+
+		inverse = inverse * ((2 + BASE - product) % BASE) % BASE;
 	}
 
-	return 0;
+	return inverse;
 }
 
-int BigInteger::GetDigitCount(std::uint32_t number)
+std::uint64_t BigInteger::DivideByWord(const Digits& dividend, std::uint64_t divisor, Digits& quotient)
 {
-	if (number >= 100000000)
-	{
-		return 9;
-	}
-	if (number >= 10000000)
-	{
-		return 8;
-	}
-	if (number >= 1000000)
-	{
-		return 7;
-	}
-	if (number >= 100000)
-	{
-		return 6;
-	}
-	if (number >= 10000)
+	size_t quotientSize = 0;
+
+	quotient.resize(dividend.size());
+
+	const std::uint64_t remainder = BigIntegerLimbs::DivideByWord(dividend, divisor, quotient, quotientSize);
+
+	quotient.resize(quotientSize);
+
+	return remainder;
+}
+
+std::uint64_t BigInteger::RemainderByWord(const Digits& dividend, std::uint64_t divisor)
+{
+	return BigIntegerLimbs::RemainderByWord(dividend, divisor);
+}
+
+void BigInteger::AssignWord(Digits& digits, std::uint64_t word)
+{
+	digits.clear();
+	digits.push_back(static_cast<std::uint32_t>(word % BASE));
+
+	if (word >= BASE)
 	{
-		return 5;
+		digits.push_back(static_cast<std::uint32_t>(word / BASE));
 	}
-	if (number >= 1000)
+}
+
+void BigInteger::IncrementMagnitude(Digits& digits)
+{
+	const std::uint32_t carry = BigIntegerSimd::AddCarryLimbs(digits.data(), digits.data(), digits.size(), 1);
+
+	if (carry > 0)
 	{
-		return 4;
+		digits.push_back(carry);
 	}
-	if (number >= 100)
+}
+
+int BigInteger::CompareMagnitude(const Digits& a, const Digits& b)
+{
+	return CompareMagnitude(a.data(), a.size(), b.data(), b.size());
+}
+
+int BigInteger::CompareMagnitude(const std::uint32_t* a, size_t aSize, const std::uint32_t* b, size_t bSize)
+{
+	return BigIntegerLimbs::CompareMagnitude(std::span<const std::uint32_t>(a, aSize), std::span<const std::uint32_t>(b, bSize));
+}
+
+std::strong_ordering BigInteger::CompareSigned(const std::uint32_t* a, size_t aSize, bool aNegative,
+	const std::uint32_t* b, size_t bSize, bool bNegative)
+{
+	if (aNegative != bNegative)
 	{
-		return 3;
+		return aNegative ? std::strong_ordering::less : std::strong_ordering::greater;
 	}
-	if (number >= 10)
+
+	const int magnitude = CompareMagnitude(a, aSize, b, bSize);
+
+	return (aNegative ? -magnitude : magnitude) <=> 0;
+}
+
+BigInteger::ScalarDigits BigInteger::ToScalarDigits(std::int64_t number)
+{
+	const std::uint64_t absNumber = number < 0 ? 0ULL - static_cast<std::uint64_t>(number) : static_cast<std::uint64_t>(number);
+
+	ScalarDigits scalar = ToScalarDigits(absNumber);
+	scalar.isNegative = number < 0;
+
+	return scalar;
+}
+
+BigInteger::ScalarDigits BigInteger::ToScalarDigits(std::uint64_t number)
+{
+	ScalarDigits scalar{ { 0, 0, 0 }, 1, false };
+
+	for (size_t i = 0; number > 0; ++i)
 	{
-		return 2;
+		scalar.digits[i] = static_cast<std::uint32_t>(number % BASE);
+		scalar.size = i + 1;
+
+		number /= BASE;
 	}
-	return 1;
+
+	return scalar;
 }
 
 void BigInteger::NormalizeDigits(Digits& digits)
@@ -2,15 +2,59 @@
 
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 #include <string>
 #include <iostream>
+#include <compare>
+#include <functional>
+#include <span>
+
+#include "BigIntegerProfiler.h"
+#include "BigIntegerSharedDigits.h"
+#include "BigIntegerView.h"
+
+struct DivRemResult;
+
+enum class DivisionMode
+{
+	// quotient rounds toward zero, remainder takes the sign of the dividend
+	Truncate,
+	// quotient rounds toward negative infinity, remainder takes the sign of the divisor
+	Floor,
+	// remainder is never negative
+	Euclidean
+};
+
+// word layout for FromBytes and ToBytes, as the order and endian arguments of mpz_import and mpz_export
+enum class WordOrder
+{
+	MostSignificantFirst,
+	LeastSignificantFirst
+};
+
+enum class ByteOrder
+{
+	BigEndian,
+	LittleEndian,
+	Native
+};
 
 class BigInteger
 {
 private:
+#if defined(BIGINTEGER_INSTRUMENTATION)
+	using Digits = std::vector<std::uint32_t, BigIntegerProfiler::CountingAllocator<std::uint32_t>>;
+#else
 	using Digits = std::vector<std::uint32_t>;
+#endif
 
-	Digits m_digits;
+#if defined(BIGINTEGER_SHARED_STORAGE)
+	using DigitStorage = BigIntegerSharedDigits<Digits>;
+#else
+	using DigitStorage = Digits;
+#endif
+
+	DigitStorage m_digits;
 	bool m_isNegative;
 
 	static constexpr std::uint64_t BASE = 1000000000ULL;
@@ -25,16 +69,13 @@ private:
 		10000000ULL,
 		100000000ULL
 	};
-	static constexpr const char* ZERO_PAD_STRINGS[9]{
-		"00000000",
-		"0000000",
-		"000000",
-		"00000",
-		"0000",
-		"000",
-		"00",
-		"0",
-		""
+
+	// native integers as limbs on the stack, 2^64 needs at most 3 limbs
+	struct ScalarDigits
+	{
+		std::uint32_t digits[3];
+		size_t size;
+		bool isNegative;
 	};
 
 public:
@@ -44,6 +85,7 @@ public:
 	BigInteger(std::int64_t number);
 	BigInteger(std::uint64_t number);
 	BigInteger(const std::string& number);
+	explicit BigInteger(const BigIntegerView& view);
 	BigInteger(const BigInteger& other);
 	BigInteger& operator=(const BigInteger& other);
 	BigInteger(BigInteger&& other) noexcept;
@@ -51,38 +93,71 @@ public:
 
 private:
 	BigInteger(Digits&& digits, bool isNegative);
-	BigInteger(const Digits& digits, bool isNegative);
+	BigInteger(const DigitStorage& digits, bool isNegative);
 
 public:
-	BigInteger operator+(const BigInteger& other) const;
-	BigInteger operator+(std::int32_t other) const;
-	BigInteger operator+(std::uint32_t other) const;
-	BigInteger operator+(std::int64_t other) const;
-	BigInteger operator+(std::uint64_t other) const;
-
-	BigInteger operator-(const BigInteger& other) const;
-	BigInteger operator-(std::int32_t other) const;
-	BigInteger operator-(std::uint32_t other) const;
-	BigInteger operator-(std::int64_t other) const;
-	BigInteger operator-(std::uint64_t other) const;
-
-	BigInteger operator*(const BigInteger& other) const;
-	BigInteger operator*(std::int32_t other) const;
-	BigInteger operator*(std::uint32_t other) const;
-	BigInteger operator*(std::int64_t other) const;
-	BigInteger operator*(std::uint64_t other) const;
-
-	BigInteger operator/(const BigInteger& other) const;
-	BigInteger operator/(std::int32_t other) const;
-	BigInteger operator/(std::uint32_t other) const;
-	BigInteger operator/(std::int64_t other) const;
-	BigInteger operator/(std::uint64_t other) const;
-
-	BigInteger operator%(const BigInteger& other) const;
-	BigInteger operator%(std::int32_t other) const;
-	BigInteger operator%(std::uint32_t other) const;
-	BigInteger operator%(std::int64_t other) const;
-	BigInteger operator%(std::uint64_t other) const;
+	// the && overloads compute into the storage of an expiring operand, so chains like (a * b + c) * d
+	// reuse one buffer instead of allocating a temporary per step
+	BigInteger operator+(const BigInteger& other) const&;
+	BigInteger operator+(const BigInteger& other) &&;
+	BigInteger operator+(BigInteger&& other) const&;
+	BigInteger operator+(BigInteger&& other) &&;
+	BigInteger operator+(std::int32_t other) const&;
+	BigInteger operator+(std::int32_t other) &&;
+	BigInteger operator+(std::uint32_t other) const&;
+	BigInteger operator+(std::uint32_t other) &&;
+	BigInteger operator+(std::int64_t other) const&;
+	BigInteger operator+(std::int64_t other) &&;
+	BigInteger operator+(std::uint64_t other) const&;
+	BigInteger operator+(std::uint64_t other) &&;
+
+	BigInteger operator-(const BigInteger& other) const&;
+	BigInteger operator-(const BigInteger& other) &&;
+	BigInteger operator-(BigInteger&& other) const&;
+	BigInteger operator-(BigInteger&& other) &&;
+	BigInteger operator-(std::int32_t other) const&;
+	BigInteger operator-(std::int32_t other) &&;
+	BigInteger operator-(std::uint32_t other) const&;
+	BigInteger operator-(std::uint32_t other) &&;
+	BigInteger operator-(std::int64_t other) const&;
+	BigInteger operator-(std::int64_t other) &&;
+	BigInteger operator-(std::uint64_t other) const&;
+	BigInteger operator-(std::uint64_t other) &&;
+
+	BigInteger operator*(const BigInteger& other) const&;
+	BigInteger operator*(const BigInteger& other) &&;
+	BigInteger operator*(BigInteger&& other) const&;
+	BigInteger operator*(BigInteger&& other) &&;
+	BigInteger operator*(std::int32_t other) const&;
+	BigInteger operator*(std::int32_t other) &&;
+	BigInteger operator*(std::uint32_t other) const&;
+	BigInteger operator*(std::uint32_t other) &&;
+	BigInteger operator*(std::int64_t other) const&;
+	BigInteger operator*(std::int64_t other) &&;
+	BigInteger operator*(std::uint64_t other) const&;
+	BigInteger operator*(std::uint64_t other) &&;
+
+	BigInteger operator/(const BigInteger& other) const&;
+	BigInteger operator/(const BigInteger& other) &&;
+	BigInteger operator/(std::int32_t other) const&;
+	BigInteger operator/(std::int32_t other) &&;
+	BigInteger operator/(std::uint32_t other) const&;
+	BigInteger operator/(std::uint32_t other) &&;
+	BigInteger operator/(std::int64_t other) const&;
+	BigInteger operator/(std::int64_t other) &&;
+	BigInteger operator/(std::uint64_t other) const&;
+	BigInteger operator/(std::uint64_t other) &&;
+
+	BigInteger operator%(const BigInteger& other) const&;
+	BigInteger operator%(const BigInteger& other) &&;
+	BigInteger operator%(std::int32_t other) const&;
+	BigInteger operator%(std::int32_t other) &&;
+	BigInteger operator%(std::uint32_t other) const&;
+	BigInteger operator%(std::uint32_t other) &&;
+	BigInteger operator%(std::int64_t other) const&;
+	BigInteger operator%(std::int64_t other) &&;
+	BigInteger operator%(std::uint64_t other) const&;
+	BigInteger operator%(std::uint64_t other) &&;
 
 	BigInteger& operator+=(const BigInteger& other);
 	BigInteger& operator+=(std::int32_t other);
@@ -114,31 +189,14 @@ public:
 	BigInteger& operator%=(std::int64_t other);
 	BigInteger& operator%=(std::uint64_t other);
 
-	BigInteger operator-() const;
+	BigInteger operator-() const&;
+	BigInteger operator-() &&;
 
-	bool operator<(const BigInteger& other) const;
-	bool operator<(std::int32_t other) const;
-	bool operator<(std::uint32_t other) const;
-	bool operator<(std::int64_t other) const;
-	bool operator<(std::uint64_t other) const;
-
-	bool operator>(const BigInteger& other) const;
-	bool operator>(std::int32_t other) const;
-	bool operator>(std::uint32_t other) const;
-	bool operator>(std::int64_t other) const;
-	bool operator>(std::uint64_t other) const;
-
-	bool operator<=(const BigInteger& other) const;
-	bool operator<=(std::int32_t other) const;
-	bool operator<=(std::uint32_t other) const;
-	bool operator<=(std::int64_t other) const;
-	bool operator<=(std::uint64_t other) const;
-
-	bool operator>=(const BigInteger& other) const;
-	bool operator>=(std::int32_t other) const;
-	bool operator>=(std::uint32_t other) const;
-	bool operator>=(std::int64_t other) const;
-	bool operator>=(std::uint64_t other) const;
+	std::strong_ordering operator<=>(const BigInteger& other) const;
+	std::strong_ordering operator<=>(std::int32_t other) const;
+	std::strong_ordering operator<=>(std::uint32_t other) const;
+	std::strong_ordering operator<=>(std::int64_t other) const;
+	std::strong_ordering operator<=>(std::uint64_t other) const;
 
 	bool operator==(const BigInteger& other) const;
 	bool operator==(std::int32_t other) const;
@@ -146,31 +204,105 @@ public:
 	bool operator==(std::int64_t other) const;
 	bool operator==(std::uint64_t other) const;
 
-	bool operator!=(const BigInteger& other) const;
-	bool operator!=(std::int32_t other) const;
-	bool operator!=(std::uint32_t other) const;
-	bool operator!=(std::int64_t other) const;
-	bool operator!=(std::uint64_t other) const;
+	std::strong_ordering Compare(const BigInteger& other) const;
+
+	// quotient and remainder from one division pass
+	static DivRemResult DivRem(const BigInteger& dividend, const BigInteger& divisor, DivisionMode mode = DivisionMode::Truncate);
+	static void DivRem(const BigInteger& dividend, const BigInteger& divisor, BigInteger& quotient, BigInteger& remainder,
+		DivisionMode mode = DivisionMode::Truncate);
+
+	// dividend must be a multiple of divisor, the remainder is never computed
+	static BigInteger DivExact(const BigInteger& dividend, const BigInteger& divisor);
+
+	// magnitude from whole words of wordSize bytes, the sign is passed separately as in mpz_import
+	static BigInteger FromBytes(std::span<const std::uint8_t> bytes, bool isNegative = false, WordOrder order = WordOrder::MostSignificantFirst,
+		size_t wordSize = 1, ByteOrder endian = ByteOrder::BigEndian);
+	// hex digits of either case after an optional '-' and "0x"
+	static BigInteger FromHex(const std::string& number);
+
+	// same text as BigInteger(const std::string&), the limbs are split across threadCount threads (0 means one per core)
+	static BigInteger ParseParallel(const std::string& number, size_t threadCount = 0);
 
 private:
 	bool IsValid(const std::string& number);
+	bool IsZero() const;
 	void Normalize();
+	// limbs for the kernels to write, detaches shared storage
+	Digits& MutableDigits();
+
+	// in-place primitives behind the operators, dividend may be *this
+	void AddSigned(const std::uint32_t* digits, size_t size, bool isNegative);
+	void AssignQuotient(const BigInteger& dividend, const BigInteger& divisor);
+	void AssignRemainder(const BigInteger& dividend, const BigInteger& divisor);
+	void AssignQuotientByScalar(const BigInteger& dividend, const ScalarDigits& divisor);
+	void AssignRemainderByScalar(const BigInteger& dividend, const ScalarDigits& divisor);
 
 public:
 	std::string ToString() const;
-	BigInteger Abs() const;
+	std::string ToStringParallel(size_t threadCount = 0) const;
+	// magnitude in as few whole words as it takes, zero is no bytes
+	std::vector<std::uint8_t> ToBytes(WordOrder order = WordOrder::MostSignificantFirst, size_t wordSize = 1,
+		ByteOrder endian = ByteOrder::BigEndian) const;
+	// lowercase without a prefix, '-' for negative numbers
+	std::string ToHex() const;
+	// valid while this object is alive and unmodified, a moved-from object is seen as zero
+	BigIntegerView GetView() const;
+	BigInteger Abs() const&;
+	BigInteger Abs() &&;
+
+	// decimal shifts, whole limbs move and the remaining 10^(k mod 9) takes one pass
+	// DivPow10 and ModPow10 truncate toward zero, x == x.DivPow10(k).MulPow10(k) + x.ModPow10(k)
+	BigInteger MulPow10(size_t exponent) const;
+	BigInteger DivPow10(size_t exponent) const;
+	BigInteger ModPow10(size_t exponent) const;
+
+	// multiply by BASE^count in place, a negative count drops the low limbs
+	void ShiftLimbs(std::ptrdiff_t count);
+	size_t Hash() const;
 
 private:
 	static void Add(const Digits& a, const Digits& b, Digits& out);
 	static void Subtract(const Digits& a, const Digits& b, Digits& out);
 	static void Multiply(const Digits& a, const Digits& b, Digits& out);
 	static void MultiplyByDigit(const Digits& a, std::uint32_t digit, Digits& out);
+	// a *= b, b must not point into a
+	static void MultiplyInPlace(Digits& a, const std::uint32_t* b, size_t bSize);
 	static void Divide(const Digits& dividend, const Digits& divisor, Digits& quotient, Digits& remainder);
 
+	// dividend must be a multiple of divisor, Hensel division from the low limbs
+	static void DivideExact(const Digits& dividend, const Digits& divisor, Digits& quotient);
+	// digit must be coprime to 10
+	static std::uint64_t InverseModBase(std::uint32_t digit);
+
+	// divisor must be below BASE^2, return the remainder
+	static std::uint64_t DivideByWord(const Digits& dividend, std::uint64_t divisor, Digits& quotient);
+	static std::uint64_t RemainderByWord(const Digits& dividend, std::uint64_t divisor);
+	static void AssignWord(Digits& digits, std::uint64_t word);
+	static void IncrementMagnitude(Digits& digits);
+
 	// return 1 when a > b, return 0 when a == b, return -1 when a < b
 	static int CompareMagnitude(const Digits& a, const Digits& b);
-	static int GetDigitCount(std::uint32_t number);
+	static int CompareMagnitude(const std::uint32_t* a, size_t aSize, const std::uint32_t* b, size_t bSize);
+	static std::strong_ordering CompareSigned(const std::uint32_t* a, size_t aSize, bool aNegative,
+		const std::uint32_t* b, size_t bSize, bool bNegative);
+	static ScalarDigits ToScalarDigits(std::int64_t number);
+	static ScalarDigits ToScalarDigits(std::uint64_t number);
 	static void NormalizeDigits(Digits& digits);
 };
 
-std::ostream& operator<<(std::ostream& os, const BigInteger& num);
\ No newline at end of file
+struct DivRemResult
+{
+	BigInteger quotient;
+	BigInteger remainder;
+};
+
+std::ostream& operator<<(std::ostream& os, const BigInteger& num);
+
+template <>
+struct std::hash<BigInteger>
+{
+	size_t operator()(const BigInteger& number) const noexcept
+	{
+		return number.Hash();
+	}
+};
\ No newline at end of file
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
+// Double-word and modular word helpers shared by the limb kernels, the NTT and the RNS.
+namespace BigIntegerArithmetic
+{
+	// return the low 64 bits of a * b and store the high 64 bits
+	inline std::uint64_t Multiply64(std::uint64_t a, std::uint64_t b, std::uint64_t& high)
+	{
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+
+		high = static_cast<std::uint64_t>(product >> 64);
+
+		return static_cast<std::uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		return _umul128(a, b, &high);
+#else
+		const std::uint64_t aLow = a & 0xFFFFFFFFULL;
+		const std::uint64_t aHigh = a >> 32;
+		const std::uint64_t bLow = b & 0xFFFFFFFFULL;
+		const std::uint64_t bHigh = b >> 32;
+
+		const std::uint64_t lowLow = aLow * bLow;
+		const std::uint64_t highLow = aHigh * bLow;
+		const std::uint64_t lowHigh = aLow * bHigh;
+		const std::uint64_t highHigh = aHigh * bHigh;
+
+		const std::uint64_t middle = (lowLow >> 32) + (highLow & 0xFFFFFFFFULL) + (lowHigh & 0xFFFFFFFFULL);
+
+		high = highHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+
+		return (middle << 32) | (lowLow & 0xFFFFFFFFULL);
+#endif
+	}
+
+	// base^exponent mod modulus, by repeated squaring
+	inline std::uint32_t PowerMod(std::uint64_t base, std::uint64_t exponent, std::uint32_t modulus)
+	{
+		std::uint64_t result = 1;
+
+		base %= modulus;
+
+		while (exponent > 0)
+		{
+			if (exponent & 1)
+			{
+				result = result * base % modulus;
+			}
+
+			base = base * base % modulus;
+			exponent >>= 1;
+		}
+
+		return static_cast<std::uint32_t>(result);
+	}
+
+	// Divides double words by a fixed divisor with a precomputed reciprocal (Moller and Granlund,
+	// "Improved division by invariant integers"), so each step is two multiplications and a fixup.
+	class WordDivider
+	{
+	private:
+		std::uint64_t m_divisor;
+		std::uint64_t m_reciprocal;
+		int m_shift;
+
+	public:
+		explicit WordDivider(std::uint64_t divisor)
+			: m_divisor{ divisor << std::countl_zero(divisor) }, m_reciprocal{ 0 }, m_shift{ std::countl_zero(divisor) }
+		{
+			// reciprocal = floor((2^128 - 1) / divisor) - 2^64, by restoring division of (~divisor : ~0)
+			std::uint64_t high = ~m_divisor;
+			std::uint64_t low = ~0ULL;
+
+			for (int i = 0; i < 64; ++i)
+			{
+				const bool overflow = (high >> 63) != 0;
+
+				high = (high << 1) | (low >> 63);
+				low <<= 1;
+				m_reciprocal <<= 1;
+
+				if (overflow || high >= m_divisor)
+				{
+					high -= m_divisor;
+					m_reciprocal |= 1;
+				}
+			}
+		}
+
+		std::uint64_t GetDivisor() const
+		{
+			return m_divisor >> m_shift;
+		}
+
+		// return (high * 2^64 + low) / divisor and store the remainder, requires high < divisor
+		std::uint64_t Divide(std::uint64_t high, std::uint64_t low, std::uint64_t& remainder) const
+		{
+			if (m_shift != 0)
+			{
+				high = (high << m_shift) | (low >> (64 - m_shift));
+				low <<= m_shift;
+			}
+
+			std::uint64_t quotientHigh = 0;
+			std::uint64_t quotientLow = Multiply64(m_reciprocal, high, quotientHigh);
+
+			quotientLow += low;
+			quotientHigh += high + 1 + (quotientLow < low ? 1 : 0);
+
+			std::uint64_t rest = low - quotientHigh * m_divisor;
+
+			if (rest > quotientLow)
+			{
+				--quotientHigh;
+				rest += m_divisor;
+			}
+
+			if (rest >= m_divisor)
+			{
+				++quotientHigh;
+				rest -= m_divisor;
+			}
+
+			remainder = rest >> m_shift;
+
+			return quotientHigh;
+		}
+
+		// return (high * base + low) / divisor and store the remainder, requires high < divisor
+		std::uint64_t DivideStep(std::uint64_t high, std::uint32_t low, std::uint64_t base, std::uint64_t& remainder) const
+		{
+			std::uint64_t productHigh = 0;
+			std::uint64_t productLow = Multiply64(high, base, productHigh);
+
+			productLow += low;
+			productHigh += productLow < low ? 1 : 0;
+
+			return Divide(productHigh, productLow, remainder);
+		}
+	};
+}
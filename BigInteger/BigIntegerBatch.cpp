@@ -0,0 +1,989 @@
+#include "BigIntegerBatch.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "BigIntegerSimd.h"
+#include "BigIntegerSimdTarget.h"
+
+namespace
+{
+	using BigIntegerSimd::InstructionSet;
+
+	constexpr std::uint32_t BASE = 1000000000U;
+	constexpr size_t MAX_LIMBS = BigIntegerBatch::MAX_LIMBS;
+
+	// rows of the three batches, lanes is the size rounded up to whole vectors
+	struct Operands
+	{
+		const std::uint32_t* a;
+		size_t strideA;
+		const std::uint32_t* b;
+		size_t strideB;
+		std::uint32_t* out;
+		size_t strideOut;
+		const std::uint32_t* signA;
+		const std::uint32_t* signB;
+		std::uint32_t* signOut;
+		size_t limbCount;
+		size_t lanes;
+	};
+
+	size_t RoundUpLanes(size_t size)
+	{
+		return (size + BigIntegerBatch::LANES - 1) / BigIntegerBatch::LANES * BigIntegerBatch::LANES;
+	}
+
+	// index of the top nonzero limb plus one, 0 for zero
+	size_t GetTopLimb(const std::uint32_t* limbs, size_t stride, size_t limbCount)
+	{
+		size_t top = limbCount;
+
+		while (top > 0 && limbs[(top - 1) * stride] == 0)
+		{
+			--top;
+		}
+
+		return top;
+	}
+
+	bool AddScalar(const Operands& o, std::uint32_t negateB)
+	{
+		bool isOverflow = false;
+
+		for (size_t i = 0; i < o.lanes; ++i)
+		{
+			std::uint32_t sums[MAX_LIMBS];
+			std::uint32_t diffs[MAX_LIMBS];
+			std::uint32_t reversed[MAX_LIMBS];
+			std::uint32_t carry = 0;
+			std::uint32_t borrow = 0;
+			std::uint32_t reverseBorrow = 0;
+
+			// both differences are formed so the choice needs no magnitude comparison up front
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				const std::uint32_t x = o.a[k * o.strideA + i];
+				const std::uint32_t y = o.b[k * o.strideB + i];
+
+				const std::uint32_t sum = x + y + carry;
+				carry = sum >= BASE ? 1 : 0;
+				sums[k] = sum - BASE * carry;
+
+				const std::uint32_t diff = x - y - borrow;
+				borrow = diff >= BASE ? 1 : 0;
+				diffs[k] = diff + BASE * borrow;
+
+				const std::uint32_t reverse = y - x - reverseBorrow;
+				reverseBorrow = reverse >= BASE ? 1 : 0;
+				reversed[k] = reverse + BASE * reverseBorrow;
+			}
+
+			const std::uint32_t signA = o.signA[i];
+			const std::uint32_t signB = o.signB[i] ^ negateB;
+			const bool isSameSign = signA == signB;
+			const std::uint32_t* result = isSameSign ? sums : (borrow != 0 ? reversed : diffs);
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				o.out[k * o.strideOut + i] = result[k];
+			}
+
+			o.signOut[i] = isSameSign || borrow == 0 ? signA : signB;
+			isOverflow = isOverflow || (isSameSign && carry != 0);
+		}
+
+		return !isOverflow;
+	}
+
+	bool MultiplyByDigitScalar(const Operands& o, std::uint32_t digit)
+	{
+		bool isOverflow = false;
+
+		for (size_t i = 0; i < o.lanes; ++i)
+		{
+			std::uint64_t carry = 0;
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				const std::uint64_t product = static_cast<std::uint64_t>(o.a[k * o.strideA + i]) * digit + carry;
+
+				o.out[k * o.strideOut + i] = static_cast<std::uint32_t>(product % BASE);
+				carry = product / BASE;
+			}
+
+			o.signOut[i] = o.signA[i];
+			isOverflow = isOverflow || carry != 0;
+		}
+
+		return !isOverflow;
+	}
+
+	bool MultiplyScalar(const Operands& o)
+	{
+		bool isOverflow = false;
+
+		for (size_t i = 0; i < o.lanes; ++i)
+		{
+			std::uint32_t a[MAX_LIMBS];
+			std::uint32_t b[MAX_LIMBS];
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				a[k] = o.a[k * o.strideA + i];
+				b[k] = o.b[k * o.strideB + i];
+			}
+
+			// a product limb past the limb count is nonzero exactly when the top limbs meet there
+			const size_t topA = GetTopLimb(o.a + i, o.strideA, o.limbCount);
+			const size_t topB = GetTopLimb(o.b + i, o.strideB, o.limbCount);
+			std::uint64_t carry = 0;
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				std::uint64_t column = carry;
+
+				for (size_t j = 0; j <= k; ++j)
+				{
+					column += static_cast<std::uint64_t>(a[j]) * b[k - j];
+				}
+
+				o.out[k * o.strideOut + i] = static_cast<std::uint32_t>(column % BASE);
+				carry = column / BASE;
+			}
+
+			o.signOut[i] = o.signA[i] ^ o.signB[i];
+			isOverflow = isOverflow || carry != 0 || topA + topB > o.limbCount + 1;
+		}
+
+		return !isOverflow;
+	}
+
+	void CompareScalar(const Operands& o, std::span<int> out)
+	{
+		for (size_t i = 0; i < out.size(); ++i)
+		{
+			int magnitude = 0;
+
+			for (size_t k = o.limbCount; k > 0 && magnitude == 0; --k)
+			{
+				const std::uint32_t x = o.a[(k - 1) * o.strideA + i];
+				const std::uint32_t y = o.b[(k - 1) * o.strideB + i];
+
+				magnitude = x > y ? 1 : (x < y ? -1 : 0);
+			}
+
+			// zero is never negative, so different signs order the numbers by sign alone
+			if (o.signA[i] != o.signB[i])
+			{
+				out[i] = o.signA[i] != 0 ? -1 : 1;
+			}
+			else
+			{
+				out[i] = o.signA[i] != 0 ? -magnitude : magnitude;
+			}
+		}
+	}
+
+#if defined(BIGINTEGER_SIMD_X86)
+	// x = quotient * BASE + remainder in each 64-bit lane, for any x with a quotient below 2^52.
+	// The double estimate of x / BASE is off by at most one, an integer correction fixes it.
+	BIGINTEGER_TARGET("avx2")
+	__m256i DivideByBaseAvx2(__m256i x, __m256i& quotient)
+	{
+		const __m256d magic = _mm256_set1_pd(4503599627370496.0);
+		const __m256i magicBits = _mm256_set1_epi64x(0x4330000000000000LL);
+		const __m256i low32 = _mm256_set1_epi64x(0xFFFFFFFFLL);
+		const __m256i base = _mm256_set1_epi64x(BASE);
+		const __m256i baseMinusOne = _mm256_set1_epi64x(BASE - 1);
+
+		// 2^52 with a 32-bit integer in its mantissa, minus 2^52, is that integer as a double
+		const __m256d low = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(x, low32), magicBits)), magic);
+		const __m256d high = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(x, 32), magicBits)), magic);
+		const __m256d value = _mm256_add_pd(_mm256_mul_pd(high, _mm256_set1_pd(4294967296.0)), low);
+		const __m256d estimate = _mm256_floor_pd(_mm256_mul_pd(value, _mm256_set1_pd(1e-9)));
+
+		__m256i q = _mm256_xor_si256(_mm256_castpd_si256(_mm256_add_pd(estimate, magic)), magicBits);
+
+		// q * BASE from the two 32-bit halves of q
+		const __m256i product = _mm256_add_epi64(_mm256_mul_epu32(q, base), _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(q, 32), base), 32));
+		__m256i r = _mm256_sub_epi64(x, product);
+
+		const __m256i isNegative = _mm256_cmpgt_epi64(_mm256_setzero_si256(), r);
+		r = _mm256_add_epi64(r, _mm256_and_si256(isNegative, base));
+		q = _mm256_add_epi64(q, isNegative);
+
+		const __m256i isOver = _mm256_cmpgt_epi64(r, baseMinusOne);
+		r = _mm256_sub_epi64(r, _mm256_and_si256(isOver, base));
+		q = _mm256_sub_epi64(q, isOver);
+
+		quotient = q;
+
+		return r;
+	}
+
+	BIGINTEGER_TARGET("avx2")
+	bool AddAvx2(const Operands& o, std::uint32_t negateB)
+	{
+		constexpr size_t LANES = 8;
+
+		const __m256i base = _mm256_set1_epi32(static_cast<int>(BASE));
+		const __m256i baseMinusOne = _mm256_set1_epi32(static_cast<int>(BASE - 1));
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i negate = _mm256_set1_epi32(static_cast<int>(negateB));
+		__m256i overflow = zero;
+
+		for (size_t g = 0; g < o.lanes; g += LANES)
+		{
+			__m256i sums[MAX_LIMBS];
+			__m256i diffs[MAX_LIMBS];
+			__m256i reversed[MAX_LIMBS];
+			// carries and borrows are all-ones masks, subtracting or adding them applies them
+			__m256i carry = zero;
+			__m256i borrow = zero;
+			__m256i reverseBorrow = zero;
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.a + k * o.strideA + g));
+				const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.b + k * o.strideB + g));
+
+				// limbs are below 2^30, so signed compares are safe
+				const __m256i sum = _mm256_sub_epi32(_mm256_add_epi32(x, y), carry);
+				carry = _mm256_cmpgt_epi32(sum, baseMinusOne);
+				sums[k] = _mm256_sub_epi32(sum, _mm256_and_si256(carry, base));
+
+				const __m256i diff = _mm256_add_epi32(_mm256_sub_epi32(x, y), borrow);
+				borrow = _mm256_cmpgt_epi32(zero, diff);
+				diffs[k] = _mm256_add_epi32(diff, _mm256_and_si256(borrow, base));
+
+				const __m256i reverse = _mm256_add_epi32(_mm256_sub_epi32(y, x), reverseBorrow);
+				reverseBorrow = _mm256_cmpgt_epi32(zero, reverse);
+				reversed[k] = _mm256_add_epi32(reverse, _mm256_and_si256(reverseBorrow, base));
+			}
+
+			const __m256i signA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.signA + g));
+			const __m256i signB = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.signB + g)), negate);
+			const __m256i isSameSign = _mm256_cmpeq_epi32(signA, signB);
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				const __m256i result = _mm256_blendv_epi8(_mm256_blendv_epi8(diffs[k], reversed[k], borrow), sums[k], isSameSign);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(o.out + k * o.strideOut + g), result);
+			}
+
+			const __m256i sign = _mm256_blendv_epi8(_mm256_blendv_epi8(signA, signB, borrow), signA, isSameSign);
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(o.signOut + g), sign);
+			overflow = _mm256_or_si256(overflow, _mm256_and_si256(isSameSign, carry));
+		}
+
+		return _mm256_testz_si256(overflow, overflow) != 0;
+	}
+
+	BIGINTEGER_TARGET("avx2")
+	bool MultiplyByDigitAvx2(const Operands& o, std::uint32_t digit)
+	{
+		constexpr size_t LANES = 8;
+
+		const __m256i multiplier = _mm256_set1_epi64x(digit);
+		__m256i overflow = _mm256_setzero_si256();
+
+		for (size_t g = 0; g < o.lanes; g += LANES)
+		{
+			// even lanes sit in the low halves of the 64-bit lanes, odd lanes are shifted down to them
+			__m256i carryEven = _mm256_setzero_si256();
+			__m256i carryOdd = _mm256_setzero_si256();
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.a + k * o.strideA + g));
+
+				const __m256i even = DivideByBaseAvx2(_mm256_add_epi64(_mm256_mul_epu32(x, multiplier), carryEven), carryEven);
+				const __m256i odd = DivideByBaseAvx2(_mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), multiplier), carryOdd), carryOdd);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(o.out + k * o.strideOut + g), _mm256_or_si256(even, _mm256_slli_epi64(odd, 32)));
+			}
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(o.signOut + g), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.signA + g)));
+			overflow = _mm256_or_si256(overflow, _mm256_or_si256(carryEven, carryOdd));
+		}
+
+		return _mm256_testz_si256(overflow, overflow) != 0;
+	}
+
+	BIGINTEGER_TARGET("avx2")
+	bool MultiplyAvx2(const Operands& o)
+	{
+		constexpr size_t LANES = 8;
+
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i limit = _mm256_set1_epi32(static_cast<int>(o.limbCount + 1));
+		__m256i overflow = zero;
+
+		for (size_t g = 0; g < o.lanes; g += LANES)
+		{
+			__m256i aEven[MAX_LIMBS];
+			__m256i aOdd[MAX_LIMBS];
+			__m256i bEven[MAX_LIMBS];
+			__m256i bOdd[MAX_LIMBS];
+			__m256i topA = zero;
+			__m256i topB = zero;
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.a + k * o.strideA + g));
+				const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.b + k * o.strideB + g));
+				const __m256i index = _mm256_set1_epi32(static_cast<int>(k + 1));
+
+				aEven[k] = x;
+				aOdd[k] = _mm256_srli_epi64(x, 32);
+				bEven[k] = y;
+				bOdd[k] = _mm256_srli_epi64(y, 32);
+
+				topA = _mm256_max_epi32(topA, _mm256_andnot_si256(_mm256_cmpeq_epi32(x, zero), index));
+				topB = _mm256_max_epi32(topB, _mm256_andnot_si256(_mm256_cmpeq_epi32(y, zero), index));
+			}
+
+			__m256i carryEven = zero;
+			__m256i carryOdd = zero;
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				__m256i columnEven = carryEven;
+				__m256i columnOdd = carryOdd;
+
+				for (size_t j = 0; j <= k; ++j)
+				{
+					columnEven = _mm256_add_epi64(columnEven, _mm256_mul_epu32(aEven[j], bEven[k - j]));
+					columnOdd = _mm256_add_epi64(columnOdd, _mm256_mul_epu32(aOdd[j], bOdd[k - j]));
+				}
+
+				const __m256i even = DivideByBaseAvx2(columnEven, carryEven);
+				const __m256i odd = DivideByBaseAvx2(columnOdd, carryOdd);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(o.out + k * o.strideOut + g), _mm256_or_si256(even, _mm256_slli_epi64(odd, 32)));
+			}
+
+			const __m256i signA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.signA + g));
+			const __m256i signB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.signB + g));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(o.signOut + g), _mm256_xor_si256(signA, signB));
+
+			overflow = _mm256_or_si256(overflow, _mm256_or_si256(carryEven, carryOdd));
+			overflow = _mm256_or_si256(overflow, _mm256_cmpgt_epi32(_mm256_add_epi32(topA, topB), limit));
+		}
+
+		return _mm256_testz_si256(overflow, overflow) != 0;
+	}
+
+	BIGINTEGER_TARGET("avx2")
+	void CompareAvx2(const Operands& o, std::span<int> out)
+	{
+		constexpr size_t LANES = 8;
+
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i one = _mm256_set1_epi32(1);
+
+		for (size_t g = 0; g < out.size(); g += LANES)
+		{
+			__m256i greater = zero;
+			__m256i less = zero;
+
+			for (size_t k = o.limbCount; k > 0; --k)
+			{
+				const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.a + (k - 1) * o.strideA + g));
+				const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.b + (k - 1) * o.strideB + g));
+				const __m256i isDecided = _mm256_or_si256(greater, less);
+
+				greater = _mm256_or_si256(greater, _mm256_andnot_si256(isDecided, _mm256_cmpgt_epi32(x, y)));
+				less = _mm256_or_si256(less, _mm256_andnot_si256(isDecided, _mm256_cmpgt_epi32(y, x)));
+			}
+
+			const __m256i signA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.signA + g));
+			const __m256i signB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o.signB + g));
+
+			// +1 for a nonnegative a, -1 for a negative one
+			const __m256i direction = _mm256_sub_epi32(one, _mm256_add_epi32(signA, signA));
+			const __m256i magnitude = _mm256_sub_epi32(less, greater);
+			const __m256i result = _mm256_blendv_epi8(_mm256_sign_epi32(magnitude, direction), direction, _mm256_xor_si256(_mm256_cmpeq_epi32(signA, signB), _mm256_set1_epi32(-1)));
+
+			int results[LANES];
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(results), result);
+			std::copy(results, results + std::min(LANES, out.size() - g), out.begin() + g);
+		}
+	}
+
+#if defined(__GNUC__) && !defined(__clang__)
+	// GCC 12 flags the undefined pass-through operand inside its own AVX-512 shift and multiply intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+	BIGINTEGER_TARGET("avx512f")
+	__m512i DivideByBaseAvx512(__m512i x, __m512i& quotient)
+	{
+		const __m512d magic = _mm512_set1_pd(4503599627370496.0);
+		const __m512i magicBits = _mm512_set1_epi64(0x4330000000000000LL);
+		const __m512i low32 = _mm512_set1_epi64(0xFFFFFFFFLL);
+		const __m512i base = _mm512_set1_epi64(BASE);
+		const __m512i baseMinusOne = _mm512_set1_epi64(BASE - 1);
+		const __m512i one = _mm512_set1_epi64(1);
+
+		const __m512d low = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_and_si512(x, low32), magicBits)), magic);
+		const __m512d high = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(x, 32), magicBits)), magic);
+		const __m512d value = _mm512_add_pd(_mm512_mul_pd(high, _mm512_set1_pd(4294967296.0)), low);
+		const __m512d estimate = _mm512_roundscale_pd(_mm512_mul_pd(value, _mm512_set1_pd(1e-9)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+
+		__m512i q = _mm512_xor_si512(_mm512_castpd_si512(_mm512_add_pd(estimate, magic)), magicBits);
+
+		const __m512i product = _mm512_add_epi64(_mm512_mul_epu32(q, base), _mm512_slli_epi64(_mm512_mul_epu32(_mm512_srli_epi64(q, 32), base), 32));
+		__m512i r = _mm512_sub_epi64(x, product);
+
+		const __mmask8 isNegative = _mm512_cmplt_epi64_mask(r, _mm512_setzero_si512());
+		r = _mm512_mask_add_epi64(r, isNegative, r, base);
+		q = _mm512_mask_sub_epi64(q, isNegative, q, one);
+
+		const __mmask8 isOver = _mm512_cmpgt_epi64_mask(r, baseMinusOne);
+		r = _mm512_mask_sub_epi64(r, isOver, r, base);
+		q = _mm512_mask_add_epi64(q, isOver, q, one);
+
+		quotient = q;
+
+		return r;
+	}
+
+	BIGINTEGER_TARGET("avx512f")
+	bool AddAvx512(const Operands& o, std::uint32_t negateB)
+	{
+		constexpr size_t LANES = 16;
+
+		const __m512i base = _mm512_set1_epi32(static_cast<int>(BASE));
+		const __m512i one = _mm512_set1_epi32(1);
+		const __m512i negate = _mm512_set1_epi32(static_cast<int>(negateB));
+		__mmask16 overflow = 0;
+
+		for (size_t g = 0; g < o.lanes; g += LANES)
+		{
+			__m512i sums[MAX_LIMBS];
+			__m512i diffs[MAX_LIMBS];
+			__m512i reversed[MAX_LIMBS];
+			__mmask16 carry = 0;
+			__mmask16 borrow = 0;
+			__mmask16 reverseBorrow = 0;
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				const __m512i x = _mm512_loadu_si512(o.a + k * o.strideA + g);
+				const __m512i y = _mm512_loadu_si512(o.b + k * o.strideB + g);
+
+				__m512i sum = _mm512_mask_add_epi32(_mm512_add_epi32(x, y), carry, _mm512_add_epi32(x, y), one);
+				carry = _mm512_cmpge_epu32_mask(sum, base);
+				sums[k] = _mm512_mask_sub_epi32(sum, carry, sum, base);
+
+				// a borrow out of x - y - borrow needs x < y + borrow, the sum cannot wrap
+				const __m512i subtrahend = _mm512_mask_add_epi32(y, borrow, y, one);
+				const __m512i reverseSubtrahend = _mm512_mask_add_epi32(x, reverseBorrow, x, one);
+
+				borrow = _mm512_cmplt_epu32_mask(x, subtrahend);
+				diffs[k] = _mm512_mask_add_epi32(_mm512_sub_epi32(x, subtrahend), borrow, _mm512_sub_epi32(x, subtrahend), base);
+
+				reverseBorrow = _mm512_cmplt_epu32_mask(y, reverseSubtrahend);
+				reversed[k] = _mm512_mask_add_epi32(_mm512_sub_epi32(y, reverseSubtrahend), reverseBorrow, _mm512_sub_epi32(y, reverseSubtrahend), base);
+			}
+
+			const __m512i signA = _mm512_loadu_si512(o.signA + g);
+			const __m512i signB = _mm512_xor_si512(_mm512_loadu_si512(o.signB + g), negate);
+			const __mmask16 isSameSign = _mm512_cmpeq_epu32_mask(signA, signB);
+			const __mmask16 isReversed = static_cast<__mmask16>(borrow & ~isSameSign);
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				const __m512i result = _mm512_mask_mov_epi32(_mm512_mask_mov_epi32(diffs[k], isReversed, reversed[k]), isSameSign, sums[k]);
+
+				_mm512_storeu_si512(o.out + k * o.strideOut + g, result);
+			}
+
+			_mm512_storeu_si512(o.signOut + g, _mm512_mask_mov_epi32(signA, isReversed, signB));
+			overflow = static_cast<__mmask16>(overflow | (isSameSign & carry));
+		}
+
+		return overflow == 0;
+	}
+
+	BIGINTEGER_TARGET("avx512f")
+	bool MultiplyByDigitAvx512(const Operands& o, std::uint32_t digit)
+	{
+		constexpr size_t LANES = 16;
+
+		const __m512i multiplier = _mm512_set1_epi64(digit);
+		__m512i overflow = _mm512_setzero_si512();
+
+		for (size_t g = 0; g < o.lanes; g += LANES)
+		{
+			__m512i carryEven = _mm512_setzero_si512();
+			__m512i carryOdd = _mm512_setzero_si512();
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				const __m512i x = _mm512_loadu_si512(o.a + k * o.strideA + g);
+
+				const __m512i even = DivideByBaseAvx512(_mm512_add_epi64(_mm512_mul_epu32(x, multiplier), carryEven), carryEven);
+				const __m512i odd = DivideByBaseAvx512(_mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(x, 32), multiplier), carryOdd), carryOdd);
+
+				_mm512_storeu_si512(o.out + k * o.strideOut + g, _mm512_or_si512(even, _mm512_slli_epi64(odd, 32)));
+			}
+
+			_mm512_storeu_si512(o.signOut + g, _mm512_loadu_si512(o.signA + g));
+			overflow = _mm512_or_si512(overflow, _mm512_or_si512(carryEven, carryOdd));
+		}
+
+		return _mm512_test_epi64_mask(overflow, overflow) == 0;
+	}
+
+	BIGINTEGER_TARGET("avx512f")
+	bool MultiplyAvx512(const Operands& o)
+	{
+		constexpr size_t LANES = 16;
+
+		const __m512i zero = _mm512_setzero_si512();
+		const __m512i limit = _mm512_set1_epi32(static_cast<int>(o.limbCount + 1));
+		__m512i carries = zero;
+		__mmask16 overflow = 0;
+
+		for (size_t g = 0; g < o.lanes; g += LANES)
+		{
+			__m512i aEven[MAX_LIMBS];
+			__m512i aOdd[MAX_LIMBS];
+			__m512i bEven[MAX_LIMBS];
+			__m512i bOdd[MAX_LIMBS];
+			__m512i topA = zero;
+			__m512i topB = zero;
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				const __m512i x = _mm512_loadu_si512(o.a + k * o.strideA + g);
+				const __m512i y = _mm512_loadu_si512(o.b + k * o.strideB + g);
+				const __m512i index = _mm512_set1_epi32(static_cast<int>(k + 1));
+
+				aEven[k] = x;
+				aOdd[k] = _mm512_srli_epi64(x, 32);
+				bEven[k] = y;
+				bOdd[k] = _mm512_srli_epi64(y, 32);
+
+				topA = _mm512_mask_mov_epi32(topA, _mm512_test_epi32_mask(x, x), index);
+				topB = _mm512_mask_mov_epi32(topB, _mm512_test_epi32_mask(y, y), index);
+			}
+
+			__m512i carryEven = zero;
+			__m512i carryOdd = zero;
+
+			for (size_t k = 0; k < o.limbCount; ++k)
+			{
+				__m512i columnEven = carryEven;
+				__m512i columnOdd = carryOdd;
+
+				for (size_t j = 0; j <= k; ++j)
+				{
+					columnEven = _mm512_add_epi64(columnEven, _mm512_mul_epu32(aEven[j], bEven[k - j]));
+					columnOdd = _mm512_add_epi64(columnOdd, _mm512_mul_epu32(aOdd[j], bOdd[k - j]));
+				}
+
+				const __m512i even = DivideByBaseAvx512(columnEven, carryEven);
+				const __m512i odd = DivideByBaseAvx512(columnOdd, carryOdd);
+
+				_mm512_storeu_si512(o.out + k * o.strideOut + g, _mm512_or_si512(even, _mm512_slli_epi64(odd, 32)));
+			}
+
+			const __m512i signA = _mm512_loadu_si512(o.signA + g);
+			const __m512i signB = _mm512_loadu_si512(o.signB + g);
+
+			_mm512_storeu_si512(o.signOut + g, _mm512_xor_si512(signA, signB));
+
+			carries = _mm512_or_si512(carries, _mm512_or_si512(carryEven, carryOdd));
+			overflow = static_cast<__mmask16>(overflow | _mm512_cmpgt_epi32_mask(_mm512_add_epi32(topA, topB), limit));
+		}
+
+		return overflow == 0 && _mm512_test_epi64_mask(carries, carries) == 0;
+	}
+
+	BIGINTEGER_TARGET("avx512f")
+	void CompareAvx512(const Operands& o, std::span<int> out)
+	{
+		constexpr size_t LANES = 16;
+
+		const __m512i zero = _mm512_setzero_si512();
+		const __m512i one = _mm512_set1_epi32(1);
+
+		for (size_t g = 0; g < out.size(); g += LANES)
+		{
+			__mmask16 greater = 0;
+			__mmask16 less = 0;
+
+			for (size_t k = o.limbCount; k > 0; --k)
+			{
+				const __m512i x = _mm512_loadu_si512(o.a + (k - 1) * o.strideA + g);
+				const __m512i y = _mm512_loadu_si512(o.b + (k - 1) * o.strideB + g);
+				const __mmask16 isDecided = static_cast<__mmask16>(greater | less);
+
+				greater = static_cast<__mmask16>(greater | (_mm512_cmpgt_epu32_mask(x, y) & ~isDecided));
+				less = static_cast<__mmask16>(less | (_mm512_cmplt_epu32_mask(x, y) & ~isDecided));
+			}
+
+			const __m512i signA = _mm512_loadu_si512(o.signA + g);
+			const __m512i signB = _mm512_loadu_si512(o.signB + g);
+			const __mmask16 isNegative = _mm512_test_epi32_mask(signA, signA);
+			const __mmask16 isSameSign = _mm512_cmpeq_epu32_mask(signA, signB);
+
+			// magnitude order, flipped for two negative numbers, sign order when the signs differ
+			__m512i result = _mm512_mask_mov_epi32(zero, greater, one);
+			result = _mm512_mask_sub_epi32(result, less, zero, one);
+			result = _mm512_mask_sub_epi32(result, isNegative, zero, result);
+			result = _mm512_mask_mov_epi32(result, static_cast<__mmask16>(~isSameSign), _mm512_sub_epi32(one, _mm512_add_epi32(signA, signA)));
+
+			int results[LANES];
+
+			_mm512_storeu_si512(results, result);
+			std::copy(results, results + std::min(LANES, out.size() - g), out.begin() + g);
+		}
+	}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+	bool AddLanes(const Operands& o, std::uint32_t negateB)
+	{
+#if defined(BIGINTEGER_SIMD_X86)
+		switch (BigIntegerSimd::GetInstructionSet())
+		{
+		case InstructionSet::Avx512:
+			return AddAvx512(o, negateB);
+		case InstructionSet::Avx2:
+			return AddAvx2(o, negateB);
+		default:
+			break;
+		}
+#endif
+
+		return AddScalar(o, negateB);
+	}
+
+	bool MultiplyByDigitLanes(const Operands& o, std::uint32_t digit)
+	{
+#if defined(BIGINTEGER_SIMD_X86)
+		switch (BigIntegerSimd::GetInstructionSet())
+		{
+		case InstructionSet::Avx512:
+			return MultiplyByDigitAvx512(o, digit);
+		case InstructionSet::Avx2:
+			return MultiplyByDigitAvx2(o, digit);
+		default:
+			break;
+		}
+#endif
+
+		return MultiplyByDigitScalar(o, digit);
+	}
+
+	bool MultiplyLanes(const Operands& o)
+	{
+#if defined(BIGINTEGER_SIMD_X86)
+		switch (BigIntegerSimd::GetInstructionSet())
+		{
+		case InstructionSet::Avx512:
+			return MultiplyAvx512(o);
+		case InstructionSet::Avx2:
+			return MultiplyAvx2(o);
+		default:
+			break;
+		}
+#endif
+
+		return MultiplyScalar(o);
+	}
+
+	void CompareLanes(const Operands& o, std::span<int> out)
+	{
+#if defined(BIGINTEGER_SIMD_X86)
+		switch (BigIntegerSimd::GetInstructionSet())
+		{
+		case InstructionSet::Avx512:
+			return CompareAvx512(o, out);
+		case InstructionSet::Avx2:
+			return CompareAvx2(o, out);
+		default:
+			break;
+		}
+#endif
+
+		CompareScalar(o, out);
+	}
+}
+
+BigIntegerBatch::BigIntegerBatch(size_t limbCount, size_t size)
+	: m_limbCount{ std::clamp<size_t>(limbCount, 1, MAX_LIMBS) }
+{
+	assert(limbCount >= 1 && limbCount <= MAX_LIMBS);
+
+	Resize(size);
+}
+
+bool BigIntegerBatch::FromValues(std::span<const BigInteger> values, size_t limbCount, BigIntegerBatch& batch)
+{
+	BigIntegerBatch result{ limbCount, values.size() };
+
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		if (!result.Set(i, values[i].GetView()))
+		{
+			return false;
+		}
+	}
+
+	batch = std::move(result);
+
+	return true;
+}
+
+std::vector<BigInteger> BigIntegerBatch::ToValues() const
+{
+	std::vector<BigInteger> values;
+
+	values.reserve(m_size);
+
+	for (size_t i = 0; i < m_size; ++i)
+	{
+		values.push_back(Get(i));
+	}
+
+	return values;
+}
+
+size_t BigIntegerBatch::GetLimbCount() const
+{
+	return m_limbCount;
+}
+
+size_t BigIntegerBatch::GetSize() const
+{
+	return m_size;
+}
+
+void BigIntegerBatch::Resize(size_t size)
+{
+	if (size > m_stride)
+	{
+		// grows geometrically so repeated PushBack stays amortized constant
+		const size_t stride = RoundUpLanes(std::max(size, m_stride * 2));
+		std::vector<std::uint32_t> limbs(m_limbCount * stride, 0);
+
+		for (size_t k = 0; k < m_limbCount; ++k)
+		{
+			std::copy_n(m_limbs.begin() + k * m_stride, m_size, limbs.begin() + k * stride);
+		}
+
+		m_limbs = std::move(limbs);
+		m_signs.resize(stride, 0);
+		m_stride = stride;
+	}
+	else
+	{
+		// dropped numbers become padding, which the kernels expect to be zero
+		for (size_t k = 0; k < m_limbCount; ++k)
+		{
+			std::fill(m_limbs.begin() + k * m_stride + std::min(size, m_size), m_limbs.begin() + k * m_stride + m_size, 0);
+		}
+
+		std::fill(m_signs.begin() + std::min(size, m_size), m_signs.begin() + m_size, 0);
+	}
+
+	m_size = size;
+}
+
+bool BigIntegerBatch::Set(size_t index, const BigIntegerView& value)
+{
+	assert(index < m_size);
+
+	const std::span<const std::uint32_t> digits = value.GetDigits();
+
+	if (index >= m_size || digits.size() > m_limbCount)
+	{
+		return false;
+	}
+
+	for (size_t k = 0; k < m_limbCount; ++k)
+	{
+		m_limbs[k * m_stride + index] = k < digits.size() ? digits[k] : 0;
+	}
+
+	m_signs[index] = value.IsNegative() ? 1 : 0;
+
+	return true;
+}
+
+bool BigIntegerBatch::PushBack(const BigIntegerView& value)
+{
+	if (value.GetDigits().size() > m_limbCount)
+	{
+		return false;
+	}
+
+	Resize(m_size + 1);
+
+	return Set(m_size - 1, value);
+}
+
+BigInteger BigIntegerBatch::Get(size_t index) const
+{
+	assert(index < m_size);
+
+	if (index >= m_size)
+	{
+		return BigInteger{};
+	}
+
+	std::uint32_t digits[MAX_LIMBS];
+	size_t size = m_limbCount;
+
+	for (size_t k = 0; k < m_limbCount; ++k)
+	{
+		digits[k] = m_limbs[k * m_stride + index];
+	}
+
+	while (size > 1 && digits[size - 1] == 0)
+	{
+		--size;
+	}
+
+	return BigInteger{ BigIntegerView{ std::span<const std::uint32_t>(digits, size), m_signs[index] != 0 } };
+}
+
+bool BigIntegerBatch::IsNegative(size_t index) const
+{
+	assert(index < m_size);
+
+	return index < m_size && m_signs[index] != 0;
+}
+
+std::span<const std::uint32_t> BigIntegerBatch::GetLimbs(size_t limb) const
+{
+	assert(limb < m_limbCount);
+
+	if (limb >= m_limbCount)
+	{
+		return {};
+	}
+
+	return std::span<const std::uint32_t>(m_limbs.data() + limb * m_stride, m_size);
+}
+
+bool BigIntegerBatch::Add(const BigIntegerBatch& a, const BigIntegerBatch& b, BigIntegerBatch& out)
+{
+	return AddSigned(a, b, false, out);
+}
+
+bool BigIntegerBatch::Subtract(const BigIntegerBatch& a, const BigIntegerBatch& b, BigIntegerBatch& out)
+{
+	return AddSigned(a, b, true, out);
+}
+
+bool BigIntegerBatch::Multiply(const BigIntegerBatch& a, const BigIntegerBatch& b, BigIntegerBatch& out)
+{
+	if (!PrepareOutput(a, b, out))
+	{
+		return false;
+	}
+
+	const bool isFitting = MultiplyLanes(Operands{ a.m_limbs.data(), a.m_stride, b.m_limbs.data(), b.m_stride, out.m_limbs.data(), out.m_stride,
+		a.m_signs.data(), b.m_signs.data(), out.m_signs.data(), a.m_limbCount, RoundUpLanes(a.m_size) });
+
+	out.NormalizeSigns();
+
+	return isFitting;
+}
+
+bool BigIntegerBatch::MultiplyByDigit(const BigIntegerBatch& a, std::uint32_t digit, BigIntegerBatch& out)
+{
+	assert(digit < BASE);
+
+	if (!PrepareOutput(a, a, out) || digit >= BASE)
+	{
+		return false;
+	}
+
+	const bool isFitting = MultiplyByDigitLanes(Operands{ a.m_limbs.data(), a.m_stride, nullptr, 0, out.m_limbs.data(), out.m_stride,
+		a.m_signs.data(), nullptr, out.m_signs.data(), a.m_limbCount, RoundUpLanes(a.m_size) }, digit);
+
+	out.NormalizeSigns();
+
+	return isFitting;
+}
+
+void BigIntegerBatch::Compare(const BigIntegerBatch& a, const BigIntegerBatch& b, std::span<int> out)
+{
+	assert(a.m_limbCount == b.m_limbCount && a.m_size == b.m_size && out.size() >= a.m_size);
+
+	if (a.m_limbCount != b.m_limbCount || a.m_size != b.m_size || out.size() < a.m_size)
+	{
+		return;
+	}
+
+	CompareLanes(Operands{ a.m_limbs.data(), a.m_stride, b.m_limbs.data(), b.m_stride, nullptr, 0,
+		a.m_signs.data(), b.m_signs.data(), nullptr, a.m_limbCount, RoundUpLanes(a.m_size) }, out.first(a.m_size));
+}
+
+bool BigIntegerBatch::PrepareOutput(const BigIntegerBatch& a, const BigIntegerBatch& b, BigIntegerBatch& out)
+{
+	assert(a.m_limbCount == b.m_limbCount && a.m_size == b.m_size && out.m_limbCount == a.m_limbCount);
+
+	if (a.m_limbCount != b.m_limbCount || a.m_size != b.m_size || out.m_limbCount != a.m_limbCount)
+	{
+		return false;
+	}
+
+	// a no-op when out is an operand
+	out.Resize(a.m_size);
+
+	return true;
+}
+
+bool BigIntegerBatch::AddSigned(const BigIntegerBatch& a, const BigIntegerBatch& b, bool isSubtraction, BigIntegerBatch& out)
+{
+	if (!PrepareOutput(a, b, out))
+	{
+		return false;
+	}
+
+	const bool isFitting = AddLanes(Operands{ a.m_limbs.data(), a.m_stride, b.m_limbs.data(), b.m_stride, out.m_limbs.data(), out.m_stride,
+		a.m_signs.data(), b.m_signs.data(), out.m_signs.data(), a.m_limbCount, RoundUpLanes(a.m_size) }, isSubtraction ? 1 : 0);
+
+	out.NormalizeSigns();
+
+	return isFitting;
+}
+
+void BigIntegerBatch::NormalizeSigns()
+{
+	std::vector<std::uint32_t> isNonzero(m_size, 0);
+
+	for (size_t k = 0; k < m_limbCount; ++k)
+	{
+		const std::uint32_t* limbs = m_limbs.data() + k * m_stride;
+
+		for (size_t i = 0; i < m_size; ++i)
+		{
+			isNonzero[i] |= limbs[i];
+		}
+	}
+
+	for (size_t i = 0; i < m_size; ++i)
+	{
+		m_signs[i] = isNonzero[i] != 0 ? m_signs[i] : 0;
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "BigInteger.h"
+#include "BigIntegerView.h"
+
+// Many small numbers of one fixed limb count, stored structure-of-arrays: limb k of every number is
+// contiguous. The kernels run across numbers instead of along limbs, so there is no carry chain between
+// vector lanes and AVX2 / AVX-512 handle 8 / 16 numbers per instruction (4 / 8 for the 64-bit products).
+//
+// Numbers are sign-magnitude like BigInteger, zero is never negative. The kernels return false when a
+// result did not fit the limb count, the overflowed numbers then hold the low limbs of the result.
+class BigIntegerBatch
+{
+public:
+	// the multiplication sums a column of products in 64 bits, which holds 16 of them
+	static constexpr size_t MAX_LIMBS = 16;
+	// numbers are stored in groups of this many so the kernels never need a scalar tail
+	static constexpr size_t LANES = 16;
+
+private:
+	size_t m_limbCount;
+	size_t m_size = 0;
+	size_t m_stride = 0;
+	// limb k of number i at k * m_stride + i, padding lanes stay zero
+	std::vector<std::uint32_t> m_limbs;
+	// 1 for negative numbers
+	std::vector<std::uint32_t> m_signs;
+
+public:
+	explicit BigIntegerBatch(size_t limbCount, size_t size = 0);
+
+	// fails when a value needs more than limbCount limbs
+	static bool FromValues(std::span<const BigInteger> values, size_t limbCount, BigIntegerBatch& batch);
+	std::vector<BigInteger> ToValues() const;
+
+public:
+	size_t GetLimbCount() const;
+	size_t GetSize() const;
+
+	// new numbers are zero
+	void Resize(size_t size);
+
+	// return false when the value needs more than GetLimbCount() limbs
+	bool Set(size_t index, const BigIntegerView& value);
+	bool PushBack(const BigIntegerView& value);
+
+	BigInteger Get(size_t index) const;
+	bool IsNegative(size_t index) const;
+
+	// limb k of every number
+	std::span<const std::uint32_t> GetLimbs(size_t limb) const;
+
+public:
+	// Element-wise, the operands need the same limb count and size. out takes their size and has to have
+	// the same limb count, it may alias an operand.
+	static bool Add(const BigIntegerBatch& a, const BigIntegerBatch& b, BigIntegerBatch& out);
+	static bool Subtract(const BigIntegerBatch& a, const BigIntegerBatch& b, BigIntegerBatch& out);
+	static bool Multiply(const BigIntegerBatch& a, const BigIntegerBatch& b, BigIntegerBatch& out);
+
+	// out = a * digit with digit below 10^9
+	static bool MultiplyByDigit(const BigIntegerBatch& a, std::uint32_t digit, BigIntegerBatch& out);
+
+	// out[i] is 1 when a[i] > b[i], 0 when a[i] == b[i] and -1 when a[i] < b[i], out has to hold GetSize() results
+	static void Compare(const BigIntegerBatch& a, const BigIntegerBatch& b, std::span<int> out);
+
+private:
+	static bool PrepareOutput(const BigIntegerBatch& a, const BigIntegerBatch& b, BigIntegerBatch& out);
+	static bool AddSigned(const BigIntegerBatch& a, const BigIntegerBatch& b, bool isSubtraction, BigIntegerBatch& out);
+
+	// the sign of each zero result is cleared
+	void NormalizeSigns();
+};
@@ -0,0 +1,294 @@
+#include "BigIntegerExpression.h"
+
+#include <algorithm>
+
+namespace
+{
+	constexpr std::uint64_t BASE = 1000000000ULL;
+
+	// every addition puts less than 2^30 into a limb, so 2^32 of them stay below 2^62
+	constexpr std::uint64_t CARRY_INTERVAL = std::uint64_t{ 1 } << 32;
+
+	// operands up to this many digits are added as a word without building a BigInteger
+	constexpr size_t WORD_DIGITS = 18;
+
+	bool IsSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+}
+
+void BigIntegerExpressionEvaluator::DeferredSum::Add(std::span<const std::uint32_t> digits)
+{
+	if (m_limbs.size() < digits.size())
+	{
+		m_limbs.resize(digits.size(), 0);
+	}
+
+	for (size_t i = 0; i < digits.size(); ++i)
+	{
+		m_limbs[i] += digits[i];
+	}
+
+	if (++m_pendingAdditions == CARRY_INTERVAL)
+	{
+		Carry();
+	}
+}
+
+void BigIntegerExpressionEvaluator::DeferredSum::Add(std::uint64_t number)
+{
+	const std::uint32_t digits[3]{
+		static_cast<std::uint32_t>(number % BASE),
+		static_cast<std::uint32_t>(number / BASE % BASE),
+		static_cast<std::uint32_t>(number / BASE / BASE)
+	};
+
+	Add(std::span<const std::uint32_t>(digits, digits[2] != 0 ? 3 : (digits[1] != 0 ? 2 : 1)));
+}
+
+BigInteger BigIntegerExpressionEvaluator::DeferredSum::ToBigInteger()
+{
+	Carry();
+
+	if (m_limbs.empty())
+	{
+		return BigInteger{};
+	}
+
+	std::vector<std::uint32_t> digits(m_limbs.begin(), m_limbs.end());
+
+	while (digits.size() > 1 && digits.back() == 0)
+	{
+		digits.pop_back();
+	}
+
+	return BigInteger{ BigIntegerView{ digits, false } };
+}
+
+void BigIntegerExpressionEvaluator::DeferredSum::Clear()
+{
+	m_limbs.clear();
+	m_pendingAdditions = 0;
+}
+
+void BigIntegerExpressionEvaluator::DeferredSum::Carry()
+{
+	std::uint64_t carry = 0;
+
+	for (std::uint64_t& limb : m_limbs)
+	{
+		limb += carry;
+		carry = limb / BASE;
+		limb %= BASE;
+	}
+
+	while (carry > 0)
+	{
+		m_limbs.push_back(carry % BASE);
+		carry /= BASE;
+	}
+
+	m_pendingAdditions = 0;
+}
+
+BigIntegerExpressionEvaluator::BigIntegerExpressionEvaluator(bool isTrailingOperatorIgnored)
+	: m_isTrailingOperatorIgnored{ isTrailingOperatorIgnored }
+{
+
+}
+
+void BigIntegerExpressionEvaluator::Append(std::string_view text)
+{
+	for (const char c : text)
+	{
+		if (!m_isValid)
+		{
+			return;
+		}
+
+		if (c >= '0' && c <= '9')
+		{
+			m_operand += c;
+			m_isExpectingOperand = false;
+			m_isAfterOperator = false;
+			m_isValid = !m_isOperandClosed;
+		}
+		else if (IsSpace(c))
+		{
+			m_isOperandClosed = !m_operand.empty();
+		}
+		else if (m_isExpectingOperand && (c == '-' || c == '+'))
+		{
+			// a sign before the operand, after another operator or at the start
+			m_isOperandNegative = m_isOperandNegative != (c == '-');
+		}
+		else if (c == '+' || c == '-' || c == '*')
+		{
+			EndOperand(c);
+			m_isExpectingOperand = true;
+			m_isOperandClosed = false;
+			m_isAfterOperator = true;
+		}
+		else
+		{
+			m_isValid = false;
+		}
+	}
+}
+
+bool BigIntegerExpressionEvaluator::Finish(BigInteger& result)
+{
+	if (m_isValid && !m_isExpectingOperand)
+	{
+		EndOperand(0);
+	}
+	else if (m_isValid && m_isAfterOperator && m_isTrailingOperatorIgnored)
+	{
+		// the operand the operator waited for never came, a pending product ends with the factors it has
+		if (!m_factors.empty())
+		{
+			const BigInteger product = TakeProduct();
+
+			(m_isTermNegative ? m_negative : m_positive).Add(product.GetView().GetDigits());
+		}
+	}
+	else
+	{
+		m_isValid = false;
+	}
+
+	const bool isValid = m_isValid;
+
+	if (isValid)
+	{
+		result = m_positive.ToBigInteger() - m_negative.ToBigInteger();
+	}
+
+	Reset();
+
+	return isValid;
+}
+
+bool BigIntegerExpressionEvaluator::Evaluate(std::string_view text, BigInteger& result, bool isTrailingOperatorIgnored)
+{
+	BigIntegerExpressionEvaluator evaluator{ isTrailingOperatorIgnored };
+
+	evaluator.Append(text);
+
+	return evaluator.Finish(result);
+}
+
+bool BigIntegerExpressionEvaluator::Evaluate(std::istream& input, BigInteger& result, bool isTrailingOperatorIgnored)
+{
+	BigIntegerExpressionEvaluator evaluator{ isTrailingOperatorIgnored };
+	std::vector<char> buffer(1 << 16);
+
+	while (input.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || input.gcount() > 0)
+	{
+		evaluator.Append(std::string_view(buffer.data(), static_cast<size_t>(input.gcount())));
+	}
+
+	return evaluator.Finish(result);
+}
+
+void BigIntegerExpressionEvaluator::EndOperand(char op)
+{
+	if (m_operand.empty())
+	{
+		m_isValid = false;
+
+		return;
+	}
+
+	const size_t firstDigit = std::min(m_operand.find_first_not_of('0'), m_operand.size() - 1);
+	const std::string_view digits = std::string_view(m_operand).substr(firstDigit);
+
+	// factors only decide the sign of their term, the magnitude is added to one of the two sums
+	m_isTermNegative = m_isTermNegative != m_isOperandNegative;
+
+	if (op == '*' || !m_factors.empty())
+	{
+		PushFactor(BigInteger{ std::string(digits) });
+	}
+	else
+	{
+		DeferredSum& sum = m_isTermNegative ? m_negative : m_positive;
+
+		if (digits.size() <= WORD_DIGITS)
+		{
+			std::uint64_t number = 0;
+
+			for (const char c : digits)
+			{
+				number = number * 10 + static_cast<std::uint64_t>(c - '0');
+			}
+
+			sum.Add(number);
+		}
+		else
+		{
+			sum.Add(BigInteger{ std::string(digits) }.GetView().GetDigits());
+		}
+	}
+
+	if (op != '*')
+	{
+		if (!m_factors.empty())
+		{
+			const BigInteger product = TakeProduct();
+
+			(m_isTermNegative ? m_negative : m_positive).Add(product.GetView().GetDigits());
+		}
+
+		// the next term starts with the sign of its operator
+		m_isTermNegative = op == '-';
+	}
+
+	m_operand.clear();
+	m_isOperandNegative = false;
+}
+
+void BigIntegerExpressionEvaluator::PushFactor(BigInteger&& factor)
+{
+	size_t level = 0;
+
+	// a binary counter over the factors, so both sides of every product are built from equally many
+	while (!m_factors.empty() && m_factors.back().second == level)
+	{
+		factor = m_factors.back().first * factor;
+		m_factors.pop_back();
+		++level;
+	}
+
+	m_factors.emplace_back(std::move(factor), level);
+}
+
+BigInteger BigIntegerExpressionEvaluator::TakeProduct()
+{
+	BigInteger product = std::move(m_factors.back().first);
+
+	m_factors.pop_back();
+
+	while (!m_factors.empty())
+	{
+		product = m_factors.back().first * product;
+		m_factors.pop_back();
+	}
+
+	return product;
+}
+
+void BigIntegerExpressionEvaluator::Reset()
+{
+	m_positive.Clear();
+	m_negative.Clear();
+	m_factors.clear();
+	m_operand.clear();
+	m_isOperandNegative = false;
+	m_isTermNegative = false;
+	m_isExpectingOperand = true;
+	m_isOperandClosed = false;
+	m_isAfterOperator = false;
+	m_isValid = true;
+}
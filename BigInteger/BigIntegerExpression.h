@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "BigInteger.h"
+
+// Evaluates + - * chains over decimal operands in one streaming pass, * binding tighter than + and -.
+// Each operand is parsed once, terms are summed limb by limb with the carries deferred, and the
+// factors of a product are multiplied in a balanced tree. Linear in the input for sums, whitespace
+// is skipped and an operand may carry its own sign ("2*-3").
+class BigIntegerExpressionEvaluator
+{
+private:
+	// limb sums without carry propagation, carried once the limbs could overflow
+	class DeferredSum
+	{
+	private:
+		std::vector<std::uint64_t> m_limbs;
+		std::uint64_t m_pendingAdditions = 0;
+
+	public:
+		void Add(std::span<const std::uint32_t> digits);
+		void Add(std::uint64_t number);
+		BigInteger ToBigInteger();
+		void Clear();
+
+	private:
+		void Carry();
+	};
+
+	DeferredSum m_positive;
+	DeferredSum m_negative;
+	// pending factors with their tree level, equal levels are merged as soon as they meet
+	std::vector<std::pair<BigInteger, size_t>> m_factors;
+	std::string m_operand;
+	bool m_isOperandNegative = false;
+	bool m_isTermNegative = false;
+	bool m_isExpectingOperand = true;
+	// whitespace after digits, a further digit would be a second operand without an operator
+	bool m_isOperandClosed = false;
+	// the last token was an operator, signs after it included
+	bool m_isAfterOperator = false;
+	bool m_isValid = true;
+	bool m_isTrailingOperatorIgnored;
+
+public:
+	// with isTrailingOperatorIgnored, operators after the last operand are dropped ("9-9-" is 0),
+	// as in inputs like worst_case.txt, otherwise they make the expression malformed
+	explicit BigIntegerExpressionEvaluator(bool isTrailingOperatorIgnored = false);
+
+	// the text may be split anywhere, even inside an operand
+	void Append(std::string_view text);
+
+	// return false when the expression was malformed, either way the evaluator is ready for a new one
+	bool Finish(BigInteger& result);
+
+	static bool Evaluate(std::string_view text, BigInteger& result, bool isTrailingOperatorIgnored = false);
+	static bool Evaluate(std::istream& input, BigInteger& result, bool isTrailingOperatorIgnored = false);
+
+private:
+	// closes the current operand, op is the operator that follows it or 0 at the end
+	void EndOperand(char op);
+	void PushFactor(BigInteger&& factor);
+	BigInteger TakeProduct();
+	void Reset();
+};
@@ -0,0 +1,43 @@
+#include "BigIntegerInternTable.h"
+
+const BigInteger& BigIntegerInternTable::Intern(const BigInteger& number)
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+
+	auto found = m_numbers.find(number);
+
+	if (found != m_numbers.end())
+	{
+		return *found;
+	}
+
+	return *m_numbers.insert(number).first;
+}
+
+const BigInteger& BigIntegerInternTable::Intern(BigInteger&& number)
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+
+	return *m_numbers.insert(std::move(number)).first;
+}
+
+bool BigIntegerInternTable::Contains(const BigInteger& number) const
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+
+	return m_numbers.find(number) != m_numbers.end();
+}
+
+size_t BigIntegerInternTable::GetSize() const
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+
+	return m_numbers.size();
+}
+
+void BigIntegerInternTable::Clear()
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+
+	m_numbers.clear();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_set>
+
+#include "BigInteger.h"
+
+// Deduplicates repeated values into one shared instance each.
+// Interned references stay valid until Clear(), so equal interned values can be compared by address.
+class BigIntegerInternTable
+{
+private:
+	std::unordered_set<BigInteger> m_numbers;
+	mutable std::mutex m_mutex;
+
+public:
+	BigIntegerInternTable() = default;
+	BigIntegerInternTable(const BigIntegerInternTable& other) = delete;
+	BigIntegerInternTable& operator=(const BigIntegerInternTable& other) = delete;
+
+public:
+	const BigInteger& Intern(const BigInteger& number);
+	const BigInteger& Intern(BigInteger&& number);
+
+	bool Contains(const BigInteger& number) const;
+	size_t GetSize() const;
+	void Clear();
+};
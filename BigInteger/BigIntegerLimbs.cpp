@@ -0,0 +1,593 @@
+#include "BigIntegerLimbs.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "BigIntegerArithmetic.h"
+#include "BigIntegerNtt.h"
+#include "BigIntegerProfiler.h"
+#include "BigIntegerSimd.h"
+#include "BigIntegerThresholds.h"
+
+namespace
+{
+	using BigIntegerLimbs::BASE;
+	using BigIntegerLimbs::WORD_BASE;
+
+	// a[0, aSize) += b[0, bSize) for aSize >= bSize, return the carry out of the top limb
+	template<std::uint64_t Base>
+	std::uint32_t AddInPlace(std::uint32_t* a, size_t aSize, const std::uint32_t* b, size_t bSize)
+	{
+		if constexpr (Base != BASE)
+		{
+			std::uint64_t carry = 0;
+
+			for (size_t i = 0; i < aSize && (i < bSize || carry > 0); ++i)
+			{
+				const std::uint64_t sum = static_cast<std::uint64_t>(a[i]) + (i < bSize ? b[i] : 0) + carry;
+
+				carry = sum >= Base ? 1 : 0;
+				a[i] = static_cast<std::uint32_t>(sum - carry * Base);
+			}
+
+			return static_cast<std::uint32_t>(carry);
+		}
+
+		const std::uint32_t carry = BigIntegerSimd::AddLimbs(a, b, a, bSize, 0);
+
+		return BigIntegerSimd::AddCarryLimbs(a + bSize, a + bSize, aSize - bSize, carry);
+	}
+
+	// a[0, aSize) -= b[0, bSize) for a >= b
+	template<std::uint64_t Base>
+	void SubtractInPlace(std::uint32_t* a, size_t aSize, const std::uint32_t* b, size_t bSize)
+	{
+		if constexpr (Base != BASE)
+		{
+			std::uint64_t borrow = 0;
+
+			for (size_t i = 0; i < aSize && (i < bSize || borrow > 0); ++i)
+			{
+				const std::uint64_t subtrahend = (i < bSize ? b[i] : 0) + borrow;
+
+				borrow = a[i] < subtrahend ? 1 : 0;
+				a[i] = static_cast<std::uint32_t>(a[i] + borrow * Base - subtrahend);
+			}
+
+			return;
+		}
+
+		const std::uint32_t borrow = BigIntegerSimd::SubtractLimbs(a, b, a, bSize, 0);
+
+		BigIntegerSimd::SubtractBorrowLimbs(a + bSize, a + bSize, aSize - bSize, borrow);
+	}
+
+	// a column below BASE plus 16 products below (BASE - 1)^2 each still fits 64 bits
+	constexpr size_t ROWS_PER_CARRY = 16;
+	// rows added in one pass over the columns, each column is loaded and stored once for all of them
+	constexpr size_t ROW_BLOCK = 4;
+	// column buffer kept on the stack, longer products take it from the heap
+	constexpr size_t STACK_COLUMNS = 256;
+
+	// columns[begin, end) to limbs below BASE, the carry runs on into the columns above
+	void CarryColumns(std::uint64_t* columns, size_t begin, size_t end)
+	{
+		std::uint64_t carry = 0;
+
+		for (size_t p = begin; p < end; ++p)
+		{
+			const std::uint64_t value = columns[p] + carry;
+
+			carry = value / BASE;
+			columns[p] = value % BASE;
+		}
+	}
+
+	// out[0, aSize + bSize) = a * b, the sizes need not be normalized. Products are summed into 64-bit
+	// columns without carrying, ROW_BLOCK rows of the shorter operand per pass, and the columns are carried
+	// once every ROWS_PER_CARRY rows instead of dividing by BASE after every product.
+	// Products of other bases fill a 64-bit column on their own and are carried after each one.
+	template<std::uint64_t Base>
+	void MultiplySchoolbook(const std::uint32_t* a, size_t aSize, const std::uint32_t* b, size_t bSize, std::uint32_t* out)
+	{
+		if (aSize < bSize)
+		{
+			std::swap(a, b);
+			std::swap(aSize, bSize);
+		}
+
+		const size_t outSize = aSize + bSize;
+
+		// too few rows to fill a block, carrying after every product is cheaper than the column buffer
+		if (Base != BASE || bSize < ROW_BLOCK)
+		{
+			std::fill(out, out + outSize, 0);
+
+			for (size_t row = 0; row < bSize; ++row)
+			{
+				std::uint64_t carry = 0;
+
+				for (size_t p = 0; p < aSize; ++p)
+				{
+					const std::uint64_t result = static_cast<std::uint64_t>(b[row]) * a[p] + out[row + p] + carry;
+
+					carry = result / Base;
+					out[row + p] = static_cast<std::uint32_t>(result % Base);
+				}
+
+				out[row + aSize] = static_cast<std::uint32_t>(carry);
+			}
+
+			return;
+		}
+
+		std::uint64_t stackColumns[STACK_COLUMNS];
+		std::vector<std::uint64_t> heapColumns;
+		std::uint64_t* columns = stackColumns;
+
+		if (outSize > STACK_COLUMNS)
+		{
+			heapColumns.resize(outSize);
+			columns = heapColumns.data();
+		}
+
+		std::fill(columns, columns + outSize, 0);
+
+		size_t row = 0;
+
+		while (row < bSize)
+		{
+			// the columns below this group of rows are already carried
+			const size_t carryBegin = row;
+			const size_t carryEnd = std::min(row + ROWS_PER_CARRY, bSize);
+
+			for (; row + ROW_BLOCK <= carryEnd; row += ROW_BLOCK)
+			{
+				const std::uint64_t d0 = b[row];
+				const std::uint64_t d1 = b[row + 1];
+				const std::uint64_t d2 = b[row + 2];
+				const std::uint64_t d3 = b[row + 3];
+				std::uint64_t* column = columns + row;
+
+				// column p takes a[p], a[p - 1], a[p - 2] and a[p - 3], all four exist from p = 3 up to aSize
+				for (size_t p = 0; p < 3; ++p)
+				{
+					column[p] += (p < aSize ? d0 * a[p] : 0) + (p >= 1 && p - 1 < aSize ? d1 * a[p - 1] : 0) + (p >= 2 && p - 2 < aSize ? d2 * a[p - 2] : 0);
+				}
+
+				for (size_t p = 3; p < aSize; ++p)
+				{
+					column[p] += d0 * a[p] + d1 * a[p - 1] + d2 * a[p - 2] + d3 * a[p - 3];
+				}
+
+				for (size_t p = std::max<size_t>(3, aSize); p < aSize + 3; ++p)
+				{
+					column[p] += (p - 1 < aSize ? d1 * a[p - 1] : 0) + (p - 2 < aSize ? d2 * a[p - 2] : 0) + d3 * a[p - 3];
+				}
+			}
+
+			for (; row < carryEnd; ++row)
+			{
+				const std::uint64_t digit = b[row];
+				std::uint64_t* column = columns + row;
+
+				for (size_t p = 0; p < aSize; ++p)
+				{
+					column[p] += digit * a[p];
+				}
+			}
+
+			CarryColumns(columns, carryBegin, std::min(row + aSize + 1, outSize));
+		}
+
+		// the product is below BASE^outSize, so the last carry stays in the top column
+		std::copy(columns, columns + outSize, out);
+	}
+
+	// out[0, aSize + bSize) = a * b, picks schoolbook, Karatsuba or the NTT by the size of the shorter operand
+	template<std::uint64_t Base>
+	void MultiplyTiered(const std::uint32_t* a, size_t aSize, const std::uint32_t* b, size_t bSize, std::uint32_t* out,
+		const BigIntegerThresholds& thresholds)
+	{
+		if (aSize < bSize)
+		{
+			std::swap(a, b);
+			std::swap(aSize, bSize);
+		}
+
+		if (bSize < thresholds.karatsubaLimbs)
+		{
+			MultiplySchoolbook<Base>(a, aSize, b, bSize, out);
+
+			return;
+		}
+
+		if constexpr (Base == BASE)
+		{
+			if (bSize >= thresholds.nttLimbs && aSize <= BigIntegerNttMultiplier::MAX_OPERAND_LIMBS)
+			{
+				std::fill(out, out + aSize + bSize, 0);
+				BigIntegerNttMultiplier().MultiplyAdd(std::span<const std::uint32_t>(a, aSize), std::span<const std::uint32_t>(b, bSize),
+					std::span<std::uint32_t>(out, aSize + bSize));
+
+				return;
+			}
+		}
+		else
+		{
+			if (bSize >= thresholds.nttLimbs && aSize + bSize <= BigIntegerNttMultiplier::MAX_PRODUCT_WORDS)
+			{
+				BigIntegerNttMultiplier().MultiplyWords(std::span<const std::uint32_t>(a, aSize), std::span<const std::uint32_t>(b, bSize),
+					std::span<std::uint32_t>(out, aSize + bSize));
+
+				return;
+			}
+		}
+
+		const size_t half = (aSize + 1) / 2;
+
+		// b too short to split with a, a is multiplied in slices of b's size instead
+		if (bSize <= half)
+		{
+			std::vector<std::uint32_t> product(2 * bSize);
+
+			std::fill(out, out + aSize + bSize, 0);
+
+			for (size_t start = 0; start < aSize; start += bSize)
+			{
+				const size_t size = std::min(bSize, aSize - start);
+
+				MultiplyTiered<Base>(a + start, size, b, bSize, product.data(), thresholds);
+				AddInPlace<Base>(out + start, aSize + bSize - start, product.data(), size + bSize);
+			}
+
+			return;
+		}
+
+		// a = a1 * Base^half + a0 and b likewise, a * b = z2 * Base^(2 half) + (z1 - z2 - z0) * Base^half + z0
+		const size_t aHighSize = aSize - half;
+		const size_t bHighSize = bSize - half;
+
+		MultiplyTiered<Base>(a, half, b, half, out, thresholds);
+		MultiplyTiered<Base>(a + half, aHighSize, b + half, bHighSize, out + 2 * half, thresholds);
+
+		std::vector<std::uint32_t> aSum(half + 1);
+		std::vector<std::uint32_t> bSum(half + 1);
+		std::vector<std::uint32_t> middle(2 * half + 2);
+
+		std::copy(a, a + half, aSum.begin());
+		aSum[half] = AddInPlace<Base>(aSum.data(), half, a + half, aHighSize);
+		std::copy(b, b + half, bSum.begin());
+		bSum[half] = AddInPlace<Base>(bSum.data(), half, b + half, bHighSize);
+
+		MultiplyTiered<Base>(aSum.data(), half + 1, bSum.data(), half + 1, middle.data(), thresholds);
+
+		SubtractInPlace<Base>(middle.data(), middle.size(), out, 2 * half);
+		SubtractInPlace<Base>(middle.data(), middle.size(), out + 2 * half, aHighSize + bHighSize);
+
+		// the high limbs of middle are zero once z0 and z2 are taken out
+		const size_t middleSize = BigIntegerLimbs::GetNormalizedSize(middle);
+
+		AddInPlace<Base>(out + half, aSize + bSize - half, middle.data(), middleSize);
+	}
+}
+
+namespace BigIntegerLimbs
+{
+	size_t GetNormalizedSize(std::span<const std::uint32_t> digits)
+	{
+		size_t size = digits.size();
+
+		while (size > 1 && digits[size - 1] == 0)
+		{
+			--size;
+		}
+
+		return size == 0 ? 1 : size;
+	}
+
+	int CompareMagnitude(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b)
+	{
+		if (a.size() != b.size())
+		{
+			return a.size() > b.size() ? 1 : -1;
+		}
+
+		return BigIntegerSimd::CompareLimbs(a.data(), b.data(), a.size());
+	}
+
+	size_t Add(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::span<std::uint32_t> out)
+	{
+		BIGINTEGER_PROFILE_KERNEL(Add, std::max(a.size(), b.size()));
+
+		const std::span<const std::uint32_t> longer = a.size() >= b.size() ? a : b;
+		const std::span<const std::uint32_t> shorter = a.size() >= b.size() ? b : a;
+
+		const size_t longerSize = longer.size();
+		const size_t shorterSize = shorter.size();
+
+		assert(out.size() > longerSize);
+
+		std::uint32_t carry = BigIntegerSimd::AddLimbs(longer.data(), shorter.data(), out.data(), shorterSize, 0);
+		carry = BigIntegerSimd::AddCarryLimbs(longer.data() + shorterSize, out.data() + shorterSize, longerSize - shorterSize, carry);
+
+		out[longerSize] = carry;
+
+		return GetNormalizedSize(out.first(longerSize + 1));
+	}
+
+	size_t Subtract(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::span<std::uint32_t> out)
+	{
+		BIGINTEGER_PROFILE_KERNEL(Subtract, a.size());
+
+		const size_t aSize = a.size();
+		const size_t bSize = b.size();
+
+		assert(aSize >= bSize && out.size() >= aSize);
+
+		const std::uint32_t borrow = BigIntegerSimd::SubtractLimbs(a.data(), b.data(), out.data(), bSize, 0);
+		BigIntegerSimd::SubtractBorrowLimbs(a.data() + bSize, out.data() + bSize, aSize - bSize, borrow);
+
+		return GetNormalizedSize(out.first(aSize));
+	}
+
+	template<std::uint64_t Base>
+	size_t Multiply(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::span<std::uint32_t> out)
+	{
+		BIGINTEGER_PROFILE_KERNEL(Multiply, a.size() + b.size());
+
+		const size_t aSize = a.size();
+		const size_t bSize = b.size();
+
+		assert(out.size() >= aSize + bSize);
+
+		MultiplyTiered<Base>(a.data(), aSize, b.data(), bSize, out.data(), BigIntegerTuning::GetThresholds());
+
+		return GetNormalizedSize(out.first(aSize + bSize));
+	}
+
+	template size_t Multiply<BASE>(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::span<std::uint32_t> out);
+	template size_t Multiply<WORD_BASE>(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::span<std::uint32_t> out);
+
+	size_t MultiplyByDigit(std::span<const std::uint32_t> a, std::uint32_t digit, std::span<std::uint32_t> out)
+	{
+		BIGINTEGER_PROFILE_KERNEL(MultiplyByDigit, a.size());
+
+		const size_t size = a.size();
+
+		assert(out.size() > size);
+
+		if (digit == 0)
+		{
+			out[0] = 0;
+
+			return 1;
+		}
+
+		// limb i is read before it is written, so out may alias a
+		std::uint64_t carry = 0;
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			std::uint64_t result = static_cast<std::uint64_t>(a[i]) * digit + carry;
+
+			carry = result / BASE;
+
+			out[i] = static_cast<std::uint32_t>(result % BASE);
+		}
+
+		out[size] = static_cast<std::uint32_t>(carry);
+
+		return GetNormalizedSize(out.first(size + 1));
+	}
+
+	size_t MultiplyInPlace(std::span<std::uint32_t> a, size_t aSize, std::span<const std::uint32_t> b)
+	{
+		const size_t bSize = b.size();
+
+		assert(a.size() >= aSize + bSize);
+
+		if (bSize == 1)
+		{
+			return MultiplyByDigit(a.first(aSize), b[0], a);
+		}
+
+		BIGINTEGER_PROFILE_KERNEL(Multiply, aSize + bSize);
+
+		// a short a is copied aside so the product can take the column kernel
+		if (aSize + bSize <= STACK_COLUMNS)
+		{
+			std::uint32_t copy[STACK_COLUMNS];
+
+			std::copy(a.begin(), a.begin() + aSize, copy);
+			MultiplySchoolbook<BASE>(copy, aSize, b.data(), bSize, a.data());
+
+			return GetNormalizedSize(a.first(aSize + bSize));
+		}
+
+		std::fill(a.begin() + aSize, a.begin() + aSize + bSize, 0);
+
+		// rows from the top limb down, limb i of a is taken before row i starts writing at position i
+		for (size_t i = aSize; i > 0; --i)
+		{
+			const std::uint64_t digit = a[i - 1];
+
+			a[i - 1] = 0;
+
+			if (digit == 0)
+			{
+				continue;
+			}
+
+			std::uint64_t carry = 0;
+
+			for (size_t j = 0; j < bSize; ++j)
+			{
+				const std::uint64_t result = digit * b[j] + a[i - 1 + j] + carry;
+
+				carry = result / BASE;
+
+				a[i - 1 + j] = static_cast<std::uint32_t>(result % BASE);
+			}
+
+			// the rows above are already in place, so the carry may run past the row
+			for (size_t k = i - 1 + bSize; carry > 0; ++k)
+			{
+				const std::uint64_t result = a[k] + carry;
+
+				carry = result / BASE;
+
+				a[k] = static_cast<std::uint32_t>(result % BASE);
+			}
+		}
+
+		return GetNormalizedSize(a.first(aSize + bSize));
+	}
+
+	void Divide(std::span<const std::uint32_t> dividend, std::span<const std::uint32_t> divisor,
+		std::span<std::uint32_t> quotient, std::span<std::uint32_t> remainder, size_t& quotientSize, size_t& remainderSize)
+	{
+		BIGINTEGER_PROFILE_KERNEL(Divide, dividend.size());
+
+		const size_t dividendSize = dividend.size();
+		const size_t divisorSize = divisor.size();
+
+		assert(quotient.size() >= dividendSize && remainder.size() >= divisorSize);
+
+		if (divisorSize == 1 && divisor[0] == 0)
+		{
+			assert(false);
+
+			quotient[0] = 0;
+			remainder[0] = 0;
+			quotientSize = 1;
+			remainderSize = 1;
+
+			return;
+		}
+
+		if (divisorSize <= 2)
+		{
+			const std::uint64_t divisorWord = divisorSize == 1 ? divisor[0] : divisor[0] + divisor[1] * BASE;
+			const std::uint64_t word = DivideByWord(dividend, divisorWord, quotient, quotientSize);
+
+			remainder[0] = static_cast<std::uint32_t>(word % BASE);
+			remainderSize = 1;
+
+			if (word >= BASE)
+			{
+				remainder[1] = static_cast<std::uint32_t>(word / BASE);
+				remainderSize = 2;
+			}
+
+			return;
+		}
+
+		const int diff = CompareMagnitude(dividend, divisor);
+
+		if (diff <= 0)
+		{
+			quotient[0] = diff == 0 ? 1 : 0;
+			quotientSize = 1;
+
+			if (diff == 0)
+			{
+				remainder[0] = 0;
+				remainderSize = 1;
+			}
+			else
+			{
+				std::copy(dividend.begin(), dividend.end(), remainder.begin());
+				remainderSize = dividendSize;
+			}
+
+			return;
+		}
+
+		// the running remainder takes one limb more than the divisor before each subtraction
+		std::vector<std::uint32_t> remain(divisorSize + 1, 0);
+		std::vector<std::uint32_t> product(divisorSize + 1, 0);
+		size_t remainSize = 0;
+
+		for (size_t i = dividendSize; i > 0; --i)
+		{
+			std::copy_backward(remain.begin(), remain.begin() + remainSize, remain.begin() + remainSize + 1);
+			remain[0] = dividend[i - 1];
+			remainSize = GetNormalizedSize(std::span<const std::uint32_t>(remain.data(), remainSize + 1));
+
+			const std::span<const std::uint32_t> current{ remain.data(), remainSize };
+
+			if (CompareMagnitude(current, divisor) < 0)
+			{
+				quotient[i - 1] = 0;
+
+				continue;
+			}
+
+			std::uint32_t left = 1;
+			std::uint32_t right = BASE - 1;
+			std::uint32_t qDigit = 0;
+
+			while (left <= right)
+			{
+				const std::uint32_t mid = left + (right - left) / 2;
+				const size_t productSize = MultiplyByDigit(divisor, mid, product);
+
+				if (CompareMagnitude(std::span<const std::uint32_t>(product.data(), productSize), current) <= 0)
+				{
+					qDigit = mid;
+					left = mid + 1;
+				}
+				else
+				{
+					right = mid - 1;
+				}
+			}
+
+			const size_t productSize = MultiplyByDigit(divisor, qDigit, product);
+
+			remainSize = Subtract(current, std::span<const std::uint32_t>(product.data(), productSize), remain);
+			quotient[i - 1] = qDigit;
+		}
+
+		quotientSize = GetNormalizedSize(quotient.first(dividendSize));
+
+		std::copy(remain.begin(), remain.begin() + remainSize, remainder.begin());
+		remainderSize = remainSize;
+	}
+
+	std::uint64_t DivideByWord(std::span<const std::uint32_t> dividend, std::uint64_t divisor,
+		std::span<std::uint32_t> quotient, size_t& quotientSize)
+	{
+		const BigIntegerArithmetic::WordDivider divider{ divisor };
+
+		assert(quotient.size() >= dividend.size());
+
+		std::uint64_t remainder = 0;
+
+		for (size_t i = dividend.size(); i > 0; --i)
+		{
+			quotient[i - 1] = static_cast<std::uint32_t>(divider.DivideStep(remainder, dividend[i - 1], BASE, remainder));
+		}
+
+		quotientSize = GetNormalizedSize(quotient.first(dividend.size()));
+
+		return remainder;
+	}
+
+	std::uint64_t RemainderByWord(std::span<const std::uint32_t> dividend, std::uint64_t divisor)
+	{
+		const BigIntegerArithmetic::WordDivider divider{ divisor };
+
+		std::uint64_t remainder = 0;
+
+		for (size_t i = dividend.size(); i > 0; --i)
+		{
+			divider.DivideStep(remainder, dividend[i - 1], BASE, remainder);
+		}
+
+		return remainder;
+	}
+}
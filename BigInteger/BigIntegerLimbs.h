@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Arithmetic on base 10^9 limb arrays, least significant limb first, for limbs that live outside a BigInteger.
+// Inputs have no leading zero limbs and zero is a single 0 limb. Results go to caller buffers
+// and every function returns the normalized size of what it wrote.
+namespace BigIntegerLimbs
+{
+	constexpr std::uint64_t BASE = 1000000000ULL;
+	// base 2^32 words, which the radix conversion multiplies with the same tiers
+	constexpr std::uint64_t WORD_BASE = 4294967296ULL;
+
+	// size without the leading zero limbs, at least 1
+	size_t GetNormalizedSize(std::span<const std::uint32_t> digits);
+
+	// return 1 when a > b, return 0 when a == b, return -1 when a < b
+	int CompareMagnitude(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b);
+
+	// out needs max(a, b) + 1 limbs, may alias a or b
+	size_t Add(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::span<std::uint32_t> out);
+
+	// requires a >= b, out needs a.size() limbs, may alias a or b
+	size_t Subtract(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::span<std::uint32_t> out);
+
+	// out needs a + b limbs and must not overlap the inputs.
+	// Schoolbook, Karatsuba or the NTT by the size of the shorter operand, see BigIntegerThresholds.
+	// Base is BASE or WORD_BASE.
+	template<std::uint64_t Base = BASE>
+	size_t Multiply(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::span<std::uint32_t> out);
+
+	// out needs a + 1 limbs, may alias a
+	size_t MultiplyByDigit(std::span<const std::uint32_t> a, std::uint32_t digit, std::span<std::uint32_t> out);
+
+	// a[0, aSize) *= b, a needs aSize + b limbs and b must not overlap a
+	size_t MultiplyInPlace(std::span<std::uint32_t> a, size_t aSize, std::span<const std::uint32_t> b);
+
+	// quotient needs dividend.size() limbs and remainder divisor.size() limbs, neither may overlap the inputs
+	void Divide(std::span<const std::uint32_t> dividend, std::span<const std::uint32_t> divisor,
+		std::span<std::uint32_t> quotient, std::span<std::uint32_t> remainder, size_t& quotientSize, size_t& remainderSize);
+
+	// divisor must be in (0, BASE^2), quotient needs dividend.size() limbs and may alias dividend, return the remainder
+	std::uint64_t DivideByWord(std::span<const std::uint32_t> dividend, std::uint64_t divisor,
+		std::span<std::uint32_t> quotient, size_t& quotientSize);
+	std::uint64_t RemainderByWord(std::span<const std::uint32_t> dividend, std::uint64_t divisor);
+}
@@ -0,0 +1,244 @@
+#include "BigIntegerMappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+BigIntegerMappedFile::BigIntegerMappedFile()
+#if defined(_WIN32)
+	: m_data{ nullptr }, m_size{ 0 }, m_isWritable{ false }, m_file{ INVALID_HANDLE_VALUE }, m_mapping{ nullptr }
+#else
+	: m_data{ nullptr }, m_size{ 0 }, m_isWritable{ false }, m_file{ -1 }
+#endif
+{
+
+}
+
+BigIntegerMappedFile::~BigIntegerMappedFile()
+{
+	Close();
+}
+
+#if defined(_WIN32)
+bool BigIntegerMappedFile::Open(const std::string& path)
+{
+	Close();
+
+	m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (m_file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER size;
+
+	if (!GetFileSizeEx(m_file, &size))
+	{
+		Close();
+
+		return false;
+	}
+
+	m_size = static_cast<size_t>(size.QuadPart);
+
+	return Map(false);
+}
+
+bool BigIntegerMappedFile::Create(const std::string& path, size_t size)
+{
+	Close();
+
+	m_file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (m_file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER end;
+	end.QuadPart = static_cast<LONGLONG>(size);
+
+	if (!SetFilePointerEx(m_file, end, nullptr, FILE_BEGIN) || !SetEndOfFile(m_file))
+	{
+		Close();
+
+		return false;
+	}
+
+	m_size = size;
+
+	return Map(true);
+}
+
+bool BigIntegerMappedFile::Map(bool isWritable)
+{
+	// an empty file cannot be mapped, it is opened with no bytes
+	if (m_size == 0)
+	{
+		return true;
+	}
+
+	m_mapping = CreateFileMappingA(m_file, nullptr, isWritable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+
+	if (m_mapping == nullptr)
+	{
+		Close();
+
+		return false;
+	}
+
+	m_data = static_cast<std::uint8_t*>(MapViewOfFile(m_mapping, isWritable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0));
+
+	if (m_data == nullptr)
+	{
+		Close();
+
+		return false;
+	}
+
+	m_isWritable = isWritable;
+
+	return true;
+}
+
+void BigIntegerMappedFile::Close()
+{
+	if (m_data != nullptr)
+	{
+		UnmapViewOfFile(m_data);
+	}
+
+	if (m_mapping != nullptr)
+	{
+		CloseHandle(m_mapping);
+	}
+
+	if (m_file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_file);
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_isWritable = false;
+	m_file = INVALID_HANDLE_VALUE;
+	m_mapping = nullptr;
+}
+
+bool BigIntegerMappedFile::IsOpen() const
+{
+	return m_file != INVALID_HANDLE_VALUE;
+}
+#else
+bool BigIntegerMappedFile::Open(const std::string& path)
+{
+	Close();
+
+	m_file = open(path.c_str(), O_RDONLY);
+
+	if (m_file < 0)
+	{
+		return false;
+	}
+
+	struct stat status;
+
+	if (fstat(m_file, &status) != 0)
+	{
+		Close();
+
+		return false;
+	}
+
+	m_size = static_cast<size_t>(status.st_size);
+
+	return Map(false);
+}
+
+bool BigIntegerMappedFile::Create(const std::string& path, size_t size)
+{
+	Close();
+
+	m_file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+	if (m_file < 0)
+	{
+		return false;
+	}
+
+	if (ftruncate(m_file, static_cast<off_t>(size)) != 0)
+	{
+		Close();
+
+		return false;
+	}
+
+	m_size = size;
+
+	return Map(true);
+}
+
+bool BigIntegerMappedFile::Map(bool isWritable)
+{
+	// an empty file cannot be mapped, it is opened with no bytes
+	if (m_size == 0)
+	{
+		return true;
+	}
+
+	void* data = mmap(nullptr, m_size, isWritable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, m_file, 0);
+
+	if (data == MAP_FAILED)
+	{
+		Close();
+
+		return false;
+	}
+
+	m_data = static_cast<std::uint8_t*>(data);
+	m_isWritable = isWritable;
+
+	return true;
+}
+
+void BigIntegerMappedFile::Close()
+{
+	if (m_data != nullptr)
+	{
+		munmap(m_data, m_size);
+	}
+
+	if (m_file >= 0)
+	{
+		close(m_file);
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_isWritable = false;
+	m_file = -1;
+}
+
+bool BigIntegerMappedFile::IsOpen() const
+{
+	return m_file >= 0;
+}
+#endif
+
+std::span<const std::uint8_t> BigIntegerMappedFile::GetBytes() const
+{
+	return { m_data, m_data == nullptr ? 0 : m_size };
+}
+
+std::span<std::uint8_t> BigIntegerMappedFile::GetMutableBytes()
+{
+	return { m_data, m_isWritable ? m_size : 0 };
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+// Memory mapping of a whole file, read-only for reading serialized arrays in place,
+// or writable for results too big to keep in RAM.
+class BigIntegerMappedFile
+{
+private:
+	std::uint8_t* m_data;
+	size_t m_size;
+	bool m_isWritable;
+
+#if defined(_WIN32)
+	void* m_file;
+	void* m_mapping;
+#else
+	int m_file;
+#endif
+
+public:
+	BigIntegerMappedFile();
+	~BigIntegerMappedFile();
+	BigIntegerMappedFile(const BigIntegerMappedFile& other) = delete;
+	BigIntegerMappedFile& operator=(const BigIntegerMappedFile& other) = delete;
+
+public:
+	// return false when the file cannot be opened or mapped
+	bool Open(const std::string& path);
+	// creates or truncates the file to size bytes and maps it writable
+	bool Create(const std::string& path, size_t size);
+	void Close();
+
+	bool IsOpen() const;
+	std::span<const std::uint8_t> GetBytes() const;
+	// empty unless the file was mapped by Create()
+	std::span<std::uint8_t> GetMutableBytes();
+
+private:
+	// maps the open file of m_size bytes
+	bool Map(bool isWritable);
+};
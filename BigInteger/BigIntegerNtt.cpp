@@ -0,0 +1,222 @@
+#include "BigIntegerNtt.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#include "BigIntegerArithmetic.h"
+
+namespace
+{
+	constexpr std::uint64_t BASE = 1000000000ULL;
+}
+
+BigIntegerNttMultiplier::BigIntegerNttMultiplier()
+{
+	const std::uint64_t product01 = static_cast<std::uint64_t>(PRIMES[0]) * PRIMES[1];
+
+	m_inverse01 = BigIntegerArithmetic::PowerMod(PRIMES[0], PRIMES[1] - 2, PRIMES[1]);
+	m_inverse012 = BigIntegerArithmetic::PowerMod(product01 % PRIMES[2], PRIMES[2] - 2, PRIMES[2]);
+	m_product01Low = product01 % BASE;
+	m_product01High = product01 / BASE;
+}
+
+void BigIntegerNttMultiplier::MultiplyAdd(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::span<std::uint32_t> accumulator)
+{
+	const size_t coefficients = a.size() + b.size() - 1;
+
+	Convolve(a, b, 3);
+
+	// a coefficient is below MAX_OPERAND_LIMBS * 10^18, it spans three limbs: d0 at its own position and d1, d2 carried up
+	std::uint64_t carry = 0;
+	std::uint64_t pending1 = 0;
+	std::uint64_t pending2 = 0;
+
+	for (size_t i = 0; i < accumulator.size(); ++i)
+	{
+		std::uint64_t d0 = 0;
+		std::uint64_t d1 = 0;
+		std::uint64_t d2 = 0;
+
+		if (i < coefficients)
+		{
+			ReconstructLimbs(m_residues[0][i], m_residues[1][i], m_residues[2][i], d0, d1, d2);
+		}
+		else if (carry == 0 && pending1 == 0 && pending2 == 0)
+		{
+			break;
+		}
+
+		const std::uint64_t sum = accumulator[i] + carry + d0 + pending1;
+
+		accumulator[i] = static_cast<std::uint32_t>(sum % BASE);
+		carry = sum / BASE;
+		pending1 = pending2 + d1;
+		pending2 = d2;
+	}
+}
+
+void BigIntegerNttMultiplier::MultiplyWords(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::span<std::uint32_t> product)
+{
+	std::vector<std::uint32_t> aHalves(2 * a.size());
+	std::vector<std::uint32_t> bHalves(2 * b.size());
+
+	for (size_t i = 0; i < a.size(); ++i)
+	{
+		aHalves[2 * i] = a[i] & 0xFFFF;
+		aHalves[2 * i + 1] = a[i] >> 16;
+	}
+
+	for (size_t i = 0; i < b.size(); ++i)
+	{
+		bHalves[2 * i] = b[i] & 0xFFFF;
+		bHalves[2 * i + 1] = b[i] >> 16;
+	}
+
+	Convolve(aHalves, bHalves, 2);
+
+	// a coefficient is below 2 * MAX_PRODUCT_WORDS * 2^32 < p0 * p1, so x0 + x1 * p0 is the coefficient itself
+	const size_t coefficients = aHalves.size() + bHalves.size() - 1;
+	std::uint64_t carry = 0;
+
+	for (size_t i = 0; i < product.size(); ++i)
+	{
+		std::uint32_t halves[2];
+
+		for (size_t j = 0; j < 2; ++j)
+		{
+			const size_t index = 2 * i + j;
+
+			if (index < coefficients)
+			{
+				const std::uint64_t x0 = m_residues[0][index];
+				const std::uint64_t x1 = (m_residues[1][index] + PRIMES[1] - x0 % PRIMES[1]) % PRIMES[1] * m_inverse01 % PRIMES[1];
+
+				carry += x0 + x1 * PRIMES[0];
+			}
+
+			halves[j] = static_cast<std::uint32_t>(carry & 0xFFFF);
+			carry >>= 16;
+		}
+
+		product[i] = halves[0] | halves[1] << 16;
+	}
+}
+
+void BigIntegerNttMultiplier::Transform(std::span<std::uint32_t> values, std::uint32_t modulus, bool isInverse)
+{
+	const size_t size = values.size();
+
+	for (size_t i = 1, j = 0; i < size; ++i)
+	{
+		size_t bit = size >> 1;
+
+		for (; j & bit; bit >>= 1)
+		{
+			j ^= bit;
+		}
+
+		j ^= bit;
+
+		if (i < j)
+		{
+			std::swap(values[i], values[j]);
+		}
+	}
+
+	for (size_t length = 2; length <= size; length <<= 1)
+	{
+		std::uint32_t root = BigIntegerArithmetic::PowerMod(PRIMITIVE_ROOT, (modulus - 1) / length, modulus);
+
+		if (isInverse)
+		{
+			root = BigIntegerArithmetic::PowerMod(root, modulus - 2, modulus);
+		}
+
+		const size_t half = length / 2;
+
+		for (size_t start = 0; start < size; start += length)
+		{
+			std::uint64_t factor = 1;
+
+			for (size_t i = 0; i < half; ++i)
+			{
+				const std::uint32_t even = values[start + i];
+				const std::uint32_t odd = static_cast<std::uint32_t>(values[start + i + half] * factor % modulus);
+
+				values[start + i] = even + odd >= modulus ? even + odd - modulus : even + odd;
+				values[start + i + half] = even >= odd ? even - odd : even + modulus - odd;
+
+				factor = factor * root % modulus;
+			}
+		}
+	}
+
+	if (isInverse)
+	{
+		const std::uint64_t inverseSize = BigIntegerArithmetic::PowerMod(size, modulus - 2, modulus);
+
+		for (std::uint32_t& value : values)
+		{
+			value = static_cast<std::uint32_t>(value * inverseSize % modulus);
+		}
+	}
+}
+
+void BigIntegerNttMultiplier::Convolve(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, size_t primeCount)
+{
+	const size_t coefficients = a.size() + b.size() - 1;
+	const size_t size = std::bit_ceil(coefficients);
+
+	m_a.resize(size);
+	m_b.resize(size);
+
+	for (size_t prime = 0; prime < primeCount; ++prime)
+	{
+		const std::uint32_t modulus = PRIMES[prime];
+
+		std::fill(m_a.begin(), m_a.end(), 0);
+		std::fill(m_b.begin(), m_b.end(), 0);
+
+		for (size_t i = 0; i < a.size(); ++i)
+		{
+			m_a[i] = a[i] % modulus;
+		}
+
+		for (size_t i = 0; i < b.size(); ++i)
+		{
+			m_b[i] = b[i] % modulus;
+		}
+
+		Transform(m_a, modulus, false);
+		Transform(m_b, modulus, false);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			m_a[i] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(m_a[i]) * m_b[i] % modulus);
+		}
+
+		Transform(m_a, modulus, true);
+
+		m_residues[prime].assign(m_a.begin(), m_a.begin() + coefficients);
+	}
+}
+
+void BigIntegerNttMultiplier::ReconstructLimbs(std::uint64_t r0, std::uint64_t r1, std::uint64_t r2,
+	std::uint64_t& d0, std::uint64_t& d1, std::uint64_t& d2) const
+{
+	const std::uint64_t x0 = r0;
+	const std::uint64_t x1 = (r1 + PRIMES[1] - x0 % PRIMES[1]) % PRIMES[1] * m_inverse01 % PRIMES[1];
+	const std::uint64_t low = x0 + x1 * PRIMES[0];
+	const std::uint64_t x2 = (r2 + PRIMES[2] - low % PRIMES[2]) % PRIMES[2] * m_inverse012 % PRIMES[2];
+
+	const std::uint64_t productLow = x2 * m_product01Low;
+	const std::uint64_t productHigh = x2 * m_product01High;
+
+	const std::uint64_t sum0 = low % BASE + productLow % BASE;
+	const std::uint64_t sum1 = low / BASE + productLow / BASE + productHigh % BASE + sum0 / BASE;
+
+	d0 = sum0 % BASE;
+	d1 = sum1 % BASE;
+	d2 = productHigh / BASE + sum1 / BASE;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Base 10^9 limb products by number theoretic transforms over three primes, joined by Garner's CRT.
+// Base 2^32 word products split each word in two 16 bit halves, whose coefficients two primes cover.
+// Keeps its transform buffers between calls, so one multiplier serves many products.
+class BigIntegerNttMultiplier
+{
+public:
+	// NTT primes with 3 as a primitive root, their product bounds a convolution coefficient of two operands
+	static constexpr size_t PRIME_COUNT = 3;
+	static constexpr std::uint32_t PRIMES[PRIME_COUNT]{ 998244353, 167772161, 469762049 };
+	static constexpr std::uint32_t PRIMITIVE_ROOT = 3;
+	// 998244353 - 1 = 119 * 2^23 limits the transform length
+	static constexpr size_t MAX_TRANSFORM_SIZE = size_t{ 1 } << 23;
+	// each operand gets half of the transform
+	static constexpr size_t MAX_OPERAND_LIMBS = MAX_TRANSFORM_SIZE / 2;
+	// two halves per word, so the words of both operands together fill half of the 2^23 transform
+	static constexpr size_t MAX_PRODUCT_WORDS = size_t{ 1 } << 22;
+
+private:
+	std::vector<std::uint32_t> m_a;
+	std::vector<std::uint32_t> m_b;
+	std::vector<std::uint32_t> m_residues[PRIME_COUNT];
+	std::uint64_t m_inverse01;
+	std::uint64_t m_inverse012;
+	std::uint64_t m_product01Low;
+	std::uint64_t m_product01High;
+
+public:
+	BigIntegerNttMultiplier();
+
+	// accumulator += a * b, neither operand may exceed MAX_OPERAND_LIMBS and the accumulator has to be big
+	// enough to take the carry. The accumulator must not overlap the operands.
+	void MultiplyAdd(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::span<std::uint32_t> accumulator);
+
+	// product[0, a + b) = a * b in base 2^32 words, a + b may not exceed MAX_PRODUCT_WORDS and the product
+	// must not overlap the operands
+	void MultiplyWords(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::span<std::uint32_t> product);
+
+	// the DFT of values modulo a prime below 2^31 with PRIMITIVE_ROOT as a primitive root, in place, in natural
+	// order, the inverse divides by the size. The size is a power of two dividing modulus - 1.
+	static void Transform(std::span<std::uint32_t> values, std::uint32_t modulus, bool isInverse);
+
+	// coefficient x = x0 + x1 * p0 + x2 * p0 * p1 from its residues, written as three base 10^9 limbs
+	void ReconstructLimbs(std::uint64_t r0, std::uint64_t r1, std::uint64_t r2, std::uint64_t& d0, std::uint64_t& d1, std::uint64_t& d2) const;
+
+private:
+	// the cyclic convolution of a and b modulo the first primeCount primes into m_residues, one value per coefficient
+	void Convolve(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, size_t primeCount);
+};
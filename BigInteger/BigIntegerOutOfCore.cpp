@@ -0,0 +1,437 @@
+#include "BigIntegerOutOfCore.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include "BigIntegerArithmetic.h"
+#include "BigIntegerMappedFile.h"
+#include "BigIntegerNtt.h"
+#include "BigIntegerProfiler.h"
+#include "BigIntegerSerialization.h"
+
+namespace
+{
+	constexpr std::uint64_t BASE = 1000000000ULL;
+
+	// NTT primes below 2^31 with 3 as a primitive root and 2^23 dividing p - 1. Their product, about 1.7 * 10^35,
+	// bounds a coefficient of operands up to 10^17 limbs, past anything a matrix holds.
+	constexpr size_t PRIME_COUNT = 4;
+	constexpr std::uint32_t PRIMES[PRIME_COUNT]{ 998244353, 167772161, 469762049, 2130706433 };
+
+	// 998244353 - 1 = 119 * 2^23 limits the length of a row and of a column, not the product
+	constexpr size_t MAX_DIMENSION = size_t{ 1 } << 23;
+
+	// rows * columns values, row by row in the scratch file
+	struct Matrix
+	{
+		std::uint32_t* values;
+		size_t rows;
+		size_t columns;
+	};
+
+	// The operands are cut into pieces of pieceLimbs, piece r in row r. With x a limb position and
+	// y = x^pieceLimbs an operand is a polynomial in x and y, and the 2D cyclic convolution of the two
+	// matrices holds the coefficient of x^c y^r of the product at (r, c) as long as neither dimension wraps.
+	// The product's coefficient k sums the ones at r * pieceLimbs + c = k.
+	struct Shape
+	{
+		size_t pieceLimbs;
+		size_t rows;
+		size_t columns;
+	};
+
+	void StoreLimb(std::uint8_t* out, std::uint32_t limb)
+	{
+		for (size_t i = 0; i < sizeof(std::uint32_t); ++i)
+		{
+			out[i] = static_cast<std::uint8_t>(limb >> (i * 8));
+		}
+	}
+
+	std::uint32_t LoadLimb(const std::uint8_t* in)
+	{
+		std::uint32_t limb = 0;
+
+		for (size_t i = 0; i < sizeof(std::uint32_t); ++i)
+		{
+			limb |= static_cast<std::uint32_t>(in[i]) << (i * 8);
+		}
+
+		return limb;
+	}
+
+	// the matrix with the fewest values whose rows have at most maxColumns, the squarer one of equal sizes.
+	// rows is 0 when no matrix fits.
+	Shape GetShape(size_t aSize, size_t bSize, size_t maxColumns)
+	{
+		const size_t shorter = std::min(aSize, bSize);
+		const size_t longer = std::max(aSize, bSize);
+
+		Shape best{ 0, 0, 0 };
+
+		for (size_t columns = 2; columns <= maxColumns; columns <<= 1)
+		{
+			// a row takes the product of a piece of each operand, their limbs less one
+			size_t pieceLimbs = columns / 2;
+
+			if (longer + shorter - 1 <= columns)
+			{
+				pieceLimbs = longer;
+			}
+			else if (shorter <= columns / 2)
+			{
+				pieceLimbs = columns + 1 - shorter;
+			}
+
+			const size_t pieces = (aSize + pieceLimbs - 1) / pieceLimbs + (bSize + pieceLimbs - 1) / pieceLimbs - 1;
+			const size_t rows = std::bit_ceil(pieces);
+
+			if (rows > MAX_DIMENSION)
+			{
+				continue;
+			}
+
+			const size_t values = rows * columns;
+			const size_t bestValues = best.rows * best.columns;
+
+			if (best.rows == 0 || values < bestValues || (values == bestValues && std::max(rows, columns) < std::max(best.rows, best.columns)))
+			{
+				best = { pieceLimbs, rows, columns };
+			}
+		}
+
+		return best;
+	}
+
+	// the limbs of piece r modulo the prime at the start of row r, the rest of the matrix zero
+	void LoadOperand(Matrix matrix, std::span<const std::uint32_t> limbs, size_t pieceLimbs, std::uint32_t modulus)
+	{
+		for (size_t row = 0; row < matrix.rows; ++row)
+		{
+			std::uint32_t* values = matrix.values + row * matrix.columns;
+			const size_t begin = std::min(row * pieceLimbs, limbs.size());
+			const size_t count = std::min(pieceLimbs, limbs.size() - begin);
+
+			for (size_t column = 0; column < count; ++column)
+			{
+				values[column] = limbs[begin + column] % modulus;
+			}
+
+			std::fill(values + count, values + matrix.columns, 0);
+		}
+	}
+
+	// a DFT of length rows down every column. The columns are gathered into the panel as many at a time as
+	// fit, each row giving a contiguous run.
+	void TransformColumns(Matrix matrix, std::uint32_t modulus, bool isInverse, std::vector<std::uint32_t>& panel)
+	{
+		const size_t rows = matrix.rows;
+		const size_t columns = matrix.columns;
+
+		// a single row is its own transform
+		if (rows == 1)
+		{
+			return;
+		}
+
+		const size_t width = panel.size() / rows;
+
+		for (size_t first = 0; first < columns; first += width)
+		{
+			const size_t count = std::min(width, columns - first);
+
+			for (size_t row = 0; row < rows; ++row)
+			{
+				const std::uint32_t* values = matrix.values + row * columns + first;
+
+				for (size_t column = 0; column < count; ++column)
+				{
+					panel[column * rows + row] = values[column];
+				}
+			}
+
+			for (size_t column = 0; column < count; ++column)
+			{
+				BigIntegerNttMultiplier::Transform(std::span<std::uint32_t>(panel.data() + column * rows, rows), modulus, isInverse);
+			}
+
+			for (size_t row = 0; row < rows; ++row)
+			{
+				std::uint32_t* values = matrix.values + row * columns + first;
+
+				for (size_t column = 0; column < count; ++column)
+				{
+					values[column] = panel[column * rows + row];
+				}
+			}
+		}
+	}
+
+	// a DFT of length columns along every row, in place, the rows are contiguous in the file
+	void TransformRows(Matrix matrix, std::uint32_t modulus, bool isInverse)
+	{
+		for (size_t row = 0; row < matrix.rows; ++row)
+		{
+			BigIntegerNttMultiplier::Transform(std::span<std::uint32_t>(matrix.values + row * matrix.columns, matrix.columns), modulus, isInverse);
+		}
+	}
+
+	// the 2D DFT, rows and columns are transformed independently
+	void Transform(Matrix matrix, std::uint32_t modulus, bool isInverse, std::vector<std::uint32_t>& panel)
+	{
+		TransformColumns(matrix, modulus, isInverse, panel);
+		TransformRows(matrix, modulus, isInverse);
+	}
+
+	// residues[k] = the sum of the values at r * pieceLimbs + c = k modulo the prime, consecutive rows overlap
+	// by columns - pieceLimbs
+	void FoldProduct(Matrix matrix, size_t pieceLimbs, std::uint32_t modulus, std::span<std::uint32_t> residues)
+	{
+		std::fill(residues.begin(), residues.end(), 0);
+
+		for (size_t row = 0; row < matrix.rows && row * pieceLimbs < residues.size(); ++row)
+		{
+			const std::uint32_t* values = matrix.values + row * matrix.columns;
+			std::uint32_t* out = residues.data() + row * pieceLimbs;
+			const size_t count = std::min(matrix.columns, residues.size() - row * pieceLimbs);
+
+			for (size_t column = 0; column < count; ++column)
+			{
+				// both below 2^31
+				const std::uint32_t sum = out[column] + values[column];
+
+				out[column] = sum >= modulus ? sum - modulus : sum;
+			}
+		}
+	}
+
+	// A coefficient from its residues by Garner's mixed radix digits, x = x0 + p0 (x1 + p1 (x2 + p2 x3)),
+	// evaluated in base 10^9.
+	class Reconstructor
+	{
+	private:
+		// m_inverses[i][j] = PRIMES[i]^-1 mod PRIMES[j] for i < j
+		std::uint64_t m_inverses[PRIME_COUNT][PRIME_COUNT];
+
+	public:
+		Reconstructor()
+			: m_inverses{}
+		{
+			for (size_t j = 0; j < PRIME_COUNT; ++j)
+			{
+				for (size_t i = 0; i < j; ++i)
+				{
+					m_inverses[i][j] = BigIntegerArithmetic::PowerMod(PRIMES[i], PRIMES[j] - 2, PRIMES[j]);
+				}
+			}
+		}
+
+		// the coefficient as PRIME_COUNT limbs, residues[prime] is its residue modulo PRIMES[prime]
+		void GetLimbs(const std::uint32_t* residues, std::uint64_t* limbs) const
+		{
+			std::uint64_t digits[PRIME_COUNT];
+
+			for (size_t j = 0; j < PRIME_COUNT; ++j)
+			{
+				const std::uint64_t modulus = PRIMES[j];
+				std::uint64_t digit = residues[j];
+
+				for (size_t i = 0; i < j; ++i)
+				{
+					digit = (digit + modulus - digits[i] % modulus) % modulus * m_inverses[i][j] % modulus;
+				}
+
+				digits[j] = digit;
+			}
+
+			std::fill(limbs, limbs + PRIME_COUNT, 0);
+
+			// Horner from the top digit, the product of the primes stays below 10^36
+			for (size_t j = PRIME_COUNT; j-- > 0;)
+			{
+				std::uint64_t carry = digits[j];
+
+				for (size_t i = 0; i < PRIME_COUNT; ++i)
+				{
+					const std::uint64_t value = limbs[i] * PRIMES[j] + carry;
+
+					limbs[i] = value % BASE;
+					carry = value / BASE;
+				}
+			}
+		}
+	};
+
+	// out[0, size) = the product whose coefficient k has residues[prime][k] for each prime. The limbs of
+	// coefficient k land on k and the PRIME_COUNT - 1 limbs above it.
+	void WriteProduct(const std::uint32_t* const* residues, size_t coefficients, std::uint8_t* out, size_t size)
+	{
+		const Reconstructor reconstructor;
+		std::uint64_t pending[PRIME_COUNT]{};
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			std::uint64_t limbs[PRIME_COUNT]{};
+
+			if (i < coefficients)
+			{
+				std::uint32_t coefficient[PRIME_COUNT];
+
+				for (size_t prime = 0; prime < PRIME_COUNT; ++prime)
+				{
+					coefficient[prime] = residues[prime][i];
+				}
+
+				reconstructor.GetLimbs(coefficient, limbs);
+			}
+
+			const std::uint64_t sum = pending[0] + limbs[0];
+
+			StoreLimb(out + i * sizeof(std::uint32_t), static_cast<std::uint32_t>(sum % BASE));
+
+			for (size_t j = 1; j < PRIME_COUNT; ++j)
+			{
+				pending[j - 1] = pending[j] + limbs[j];
+			}
+
+			pending[PRIME_COUNT - 1] = 0;
+			pending[0] += sum / BASE;
+		}
+	}
+
+	// out[0, a + b) = a * b for nonzero operands, the transforms in a scratch file at scratchPath that is
+	// removed again. return false when no matrix fits or the scratch file cannot be created
+	bool MultiplyLimbs(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b, std::uint8_t* out,
+		const std::string& scratchPath, size_t memoryBudget)
+	{
+		// a row is transformed in place, so it is kept within the budget like the panel
+		const size_t maxColumns = std::clamp<size_t>(std::bit_floor(memoryBudget / sizeof(std::uint32_t)), 2, MAX_DIMENSION);
+		const Shape shape = GetShape(a.size(), b.size(), maxColumns);
+
+		if (shape.rows == 0)
+		{
+			return false;
+		}
+
+		const size_t transformSize = shape.rows * shape.columns;
+		const size_t coefficients = a.size() + b.size() - 1;
+
+		// the transforms of both operands, then the product's residues for every prime
+		BigIntegerMappedFile scratch;
+		std::error_code error;
+
+		if (!scratch.Create(scratchPath, (2 * transformSize + PRIME_COUNT * coefficients) * sizeof(std::uint32_t)))
+		{
+			std::filesystem::remove(scratchPath, error);
+
+			return false;
+		}
+
+		BIGINTEGER_PROFILE_KERNEL(Multiply, a.size() + b.size());
+
+		std::uint32_t* values = reinterpret_cast<std::uint32_t*>(scratch.GetMutableBytes().data());
+		const Matrix product{ values, shape.rows, shape.columns };
+		const Matrix other{ values + transformSize, shape.rows, shape.columns };
+
+		// as many columns as the budget holds, at least one
+		const size_t panelColumns = std::clamp<size_t>(memoryBudget / sizeof(std::uint32_t) / shape.rows, 1, shape.columns);
+		std::vector<std::uint32_t> panel(shape.rows > 1 ? shape.rows * panelColumns : 0);
+		const std::uint32_t* residues[PRIME_COUNT];
+
+		for (size_t prime = 0; prime < PRIME_COUNT; ++prime)
+		{
+			const std::uint32_t modulus = PRIMES[prime];
+			std::uint32_t* primeResidues = values + 2 * transformSize + prime * coefficients;
+
+			LoadOperand(product, a, shape.pieceLimbs, modulus);
+			Transform(product, modulus, false, panel);
+			LoadOperand(other, b, shape.pieceLimbs, modulus);
+			Transform(other, modulus, false, panel);
+
+			for (size_t i = 0; i < transformSize; ++i)
+			{
+				product.values[i] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(product.values[i]) * other.values[i] % modulus);
+			}
+
+			Transform(product, modulus, true, panel);
+			FoldProduct(product, shape.pieceLimbs, modulus, std::span<std::uint32_t>(primeResidues, coefficients));
+			residues[prime] = primeResidues;
+		}
+
+		WriteProduct(residues, coefficients, out, a.size() + b.size());
+
+		scratch.Close();
+		std::filesystem::remove(scratchPath, error);
+
+		return true;
+	}
+}
+
+namespace BigIntegerOutOfCore
+{
+	bool Multiply(const BigIntegerView& a, const BigIntegerView& b, const std::string& path, size_t memoryBudget)
+	{
+		const std::span<const std::uint32_t> aDigits = a.GetDigits();
+		const std::span<const std::uint32_t> bDigits = b.GetDigits();
+
+		const bool isZero = a.IsZero() || b.IsZero();
+		const size_t size = isZero ? 1 : aDigits.size() + bDigits.size();
+
+		// written beside path and renamed over it at the end, so path may be the file an operand is mapped from
+		const std::string partialPath = path + ".partial";
+		BigIntegerMappedFile file;
+		std::error_code error;
+
+		if (!file.Create(partialPath, BigIntegerSerialization::VALUE_HEADER_SIZE + size * sizeof(std::uint32_t)))
+		{
+			std::filesystem::remove(partialPath, error);
+
+			return false;
+		}
+
+		std::uint8_t* header = file.GetMutableBytes().data();
+		std::uint8_t* out = header + BigIntegerSerialization::VALUE_HEADER_SIZE;
+
+		if (isZero)
+		{
+			StoreLimb(out, 0);
+		}
+		else if (!MultiplyLimbs(aDigits, bDigits, out, path + ".scratch", memoryBudget))
+		{
+			file.Close();
+			std::filesystem::remove(partialPath, error);
+
+			return false;
+		}
+
+		// the product of normalized operands has size or size - 1 limbs
+		const size_t normalizedSize = size > 1 && LoadLimb(out + (size - 1) * sizeof(std::uint32_t)) == 0 ? size - 1 : size;
+
+		BigIntegerSerialization::WriteValueHeader(header, normalizedSize, !isZero && a.IsNegative() != b.IsNegative());
+		file.Close();
+
+		if (normalizedSize != size)
+		{
+			std::filesystem::resize_file(partialPath, BigIntegerSerialization::VALUE_HEADER_SIZE + normalizedSize * sizeof(std::uint32_t), error);
+		}
+
+		if (!error)
+		{
+			std::filesystem::rename(partialPath, path, error);
+		}
+
+		if (error)
+		{
+			std::filesystem::remove(partialPath, error);
+
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "BigIntegerView.h"
+
+// Multiplication of numbers too big to keep in RAM next to their product.
+// The operands are read in place, usually views from BigIntegerSerialization::DeserializeView over a
+// BigIntegerMappedFile, and the product is written to a mapped file as one serialized value record.
+// Each operand is cut into pieces laid out as the rows of a matrix, and the product is their 2D cyclic
+// convolution by a four-prime NTT whose transforms live in a mapped scratch file next to the result.
+// Neither a row nor a column wraps, so each dimension needs a root of its own length only and the
+// operands may be of any size. Columns are transformed in a heap panel a batch at a time, rows in
+// place where they are contiguous in the file. Every pass walks the file front to back, so a product
+// costs O(n log n) with a few sequential passes, each operand transformed once per prime.
+namespace BigIntegerOutOfCore
+{
+	constexpr size_t DEFAULT_MEMORY_BUDGET = 256 << 20;
+
+	// memoryBudget bounds the column panel and the length of a row, so the pages a transform works on stay
+	// resident, the rest of the mapping is left to the OS to evict. The scratch file, path + ".scratch",
+	// takes up to 48 bytes per limb of the product and is removed at the end. The product is written to
+	// path + ".partial" and renamed to path once complete, so path may be the file an operand is mapped from.
+	// return false when a file cannot be created or renamed, nothing is left at path then
+	bool Multiply(const BigIntegerView& a, const BigIntegerView& b, const std::string& path,
+		size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Splits [0, count) into contiguous chunks, one per thread.
+namespace BigIntegerParallel
+{
+	// requested 0 means one thread per core, never more threads than chunks of minPerThread items
+	inline size_t GetThreadCount(size_t requested, size_t count, size_t minPerThread)
+	{
+		const size_t hardware = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+		const size_t threads = requested == 0 ? hardware : requested;
+
+		return std::max<size_t>(std::min(threads, count / std::max<size_t>(minPerThread, 1)), 1);
+	}
+
+	// calls function(chunk, begin, end) for every chunk, the calling thread takes the first one
+	template<typename Function>
+	void ForEachChunk(size_t count, size_t threadCount, Function function)
+	{
+		const size_t chunkSize = (count + threadCount - 1) / threadCount;
+
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount - 1);
+
+		for (size_t chunk = 1; chunk < threadCount; ++chunk)
+		{
+			const size_t begin = std::min(chunk * chunkSize, count);
+			const size_t end = std::min(begin + chunkSize, count);
+
+			threads.emplace_back(function, chunk, begin, end);
+		}
+
+		function(0, 0, std::min(chunkSize, count));
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+}
@@ -0,0 +1,280 @@
+#include "BigIntegerProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace
+{
+	using BigIntegerProfiler::HISTOGRAM_BUCKETS;
+	using BigIntegerProfiler::KERNEL_COUNT;
+
+	// written only by the owning thread, read by snapshots from any thread
+	struct Counter
+	{
+		std::atomic<std::uint64_t> value{ 0 };
+
+		void Add(std::uint64_t amount)
+		{
+			value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
+
+		std::uint64_t Get() const
+		{
+			return value.load(std::memory_order_relaxed);
+		}
+	};
+
+	struct KernelCounters
+	{
+		Counter calls;
+		Counter limbs;
+		Counter cycles;
+		Counter limbHistogram[HISTOGRAM_BUCKETS];
+	};
+
+	struct ThreadCounters
+	{
+		KernelCounters kernels[KERNEL_COUNT];
+		Counter allocations;
+		Counter allocatedBytes;
+
+		ThreadCounters();
+		~ThreadCounters();
+	};
+
+	struct Registry
+	{
+		std::mutex mutex;
+		std::vector<ThreadCounters*> threads;
+		BigIntegerProfiler::Snapshot retired{};
+	};
+
+	// never destroyed, thread counters can outlive static destruction
+	Registry& GetRegistry()
+	{
+		static Registry* registry = new Registry();
+
+		return *registry;
+	}
+
+	void Accumulate(const ThreadCounters& counters, BigIntegerProfiler::Snapshot& snapshot)
+	{
+		for (size_t k = 0; k < KERNEL_COUNT; ++k)
+		{
+			const KernelCounters& source = counters.kernels[k];
+			BigIntegerProfiler::KernelStats& target = snapshot.kernels[k];
+
+			target.calls += source.calls.Get();
+			target.limbs += source.limbs.Get();
+			target.cycles += source.cycles.Get();
+
+			for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b)
+			{
+				target.limbHistogram[b] += source.limbHistogram[b].Get();
+			}
+		}
+
+		snapshot.allocations += counters.allocations.Get();
+		snapshot.allocatedBytes += counters.allocatedBytes.Get();
+	}
+
+	void Clear(ThreadCounters& counters)
+	{
+		for (KernelCounters& kernel : counters.kernels)
+		{
+			kernel.calls.value.store(0, std::memory_order_relaxed);
+			kernel.limbs.value.store(0, std::memory_order_relaxed);
+			kernel.cycles.value.store(0, std::memory_order_relaxed);
+
+			for (Counter& bucket : kernel.limbHistogram)
+			{
+				bucket.value.store(0, std::memory_order_relaxed);
+			}
+		}
+
+		counters.allocations.value.store(0, std::memory_order_relaxed);
+		counters.allocatedBytes.value.store(0, std::memory_order_relaxed);
+	}
+
+	ThreadCounters::ThreadCounters()
+	{
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock{ registry.mutex };
+
+		registry.threads.push_back(this);
+	}
+
+	ThreadCounters::~ThreadCounters()
+	{
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock{ registry.mutex };
+
+		Accumulate(*this, registry.retired);
+
+		std::erase(registry.threads, this);
+	}
+
+	ThreadCounters& GetThreadCounters()
+	{
+		thread_local ThreadCounters counters;
+
+		return counters;
+	}
+}
+
+namespace BigIntegerProfiler
+{
+	const char* GetKernelName(Kernel kernel)
+	{
+		switch (kernel)
+		{
+		case Kernel::Add:
+			return "Add";
+		case Kernel::Subtract:
+			return "Subtract";
+		case Kernel::Multiply:
+			return "Multiply";
+		case Kernel::MultiplyByDigit:
+			return "MultiplyByDigit";
+		case Kernel::Divide:
+			return "Divide";
+		case Kernel::Normalize:
+			return "Normalize";
+		case Kernel::Parse:
+			return "Parse";
+		case Kernel::Format:
+			return "Format";
+		default:
+			return "Unknown";
+		}
+	}
+
+	Snapshot TakeSnapshot()
+	{
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock{ registry.mutex };
+
+		Snapshot snapshot = registry.retired;
+
+		for (const ThreadCounters* counters : registry.threads)
+		{
+			Accumulate(*counters, snapshot);
+		}
+
+		return snapshot;
+	}
+
+	void Reset()
+	{
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock{ registry.mutex };
+
+		registry.retired = Snapshot{};
+
+		for (ThreadCounters* counters : registry.threads)
+		{
+			Clear(*counters);
+		}
+	}
+
+	std::uint64_t ReadCycles()
+	{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+	}
+
+	void RecordKernel(Kernel kernel, size_t limbs, std::uint64_t cycles)
+	{
+		KernelCounters& counters = GetThreadCounters().kernels[static_cast<size_t>(kernel)];
+
+		const size_t bucket = std::min<size_t>(std::bit_width(limbs), HISTOGRAM_BUCKETS - 1);
+
+		counters.calls.Add(1);
+		counters.limbs.Add(limbs);
+		counters.cycles.Add(cycles);
+		counters.limbHistogram[bucket].Add(1);
+	}
+
+	void RecordAllocation(size_t bytes)
+	{
+		ThreadCounters& counters = GetThreadCounters();
+
+		counters.allocations.Add(1);
+		counters.allocatedBytes.Add(bytes);
+	}
+
+	std::string Snapshot::ToText() const
+	{
+		std::ostringstream oss;
+
+		oss << "kernel            calls        limbs        cycles\n";
+
+		for (size_t k = 0; k < KERNEL_COUNT; ++k)
+		{
+			const KernelStats& stats = kernels[k];
+			const std::string name = GetKernelName(static_cast<Kernel>(k));
+
+			oss << name << std::string(name.size() < 18 ? 18 - name.size() : 1, ' ')
+				<< stats.calls << ' ' << stats.limbs << ' ' << stats.cycles << '\n';
+
+			for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b)
+			{
+				if (stats.limbHistogram[b] == 0)
+				{
+					continue;
+				}
+
+				const std::uint64_t low = b == 0 ? 0 : 1ULL << (b - 1);
+
+				oss << "  limbs >= " << low << ": " << stats.limbHistogram[b] << '\n';
+			}
+		}
+
+		oss << "allocations " << allocations << ", bytes " << allocatedBytes << '\n';
+
+		return oss.str();
+	}
+
+	std::string Snapshot::ToJson() const
+	{
+		std::ostringstream oss;
+
+		oss << "{\"enabled\":" << (IsEnabled() ? "true" : "false") << ",\"kernels\":{";
+
+		for (size_t k = 0; k < KERNEL_COUNT; ++k)
+		{
+			const KernelStats& stats = kernels[k];
+
+			oss << (k == 0 ? "" : ",") << '"' << GetKernelName(static_cast<Kernel>(k)) << "\":{"
+				<< "\"calls\":" << stats.calls
+				<< ",\"limbs\":" << stats.limbs
+				<< ",\"cycles\":" << stats.cycles
+				<< ",\"limb_histogram\":[";
+
+			for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b)
+			{
+				oss << (b == 0 ? "" : ",") << stats.limbHistogram[b];
+			}
+
+			oss << "]}";
+		}
+
+		oss << "},\"allocations\":" << allocations << ",\"allocated_bytes\":" << allocatedBytes << "}";
+
+		return oss.str();
+	}
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Hot-path instrumentation, compiled in only when BIGINTEGER_INSTRUMENTATION is defined.
+// Counters are kept per thread and summed when a snapshot is taken.
+namespace BigIntegerProfiler
+{
+	enum class Kernel
+	{
+		Add,
+		Subtract,
+		Multiply,
+		MultiplyByDigit,
+		Divide,
+		Normalize,
+		Parse,
+		Format,
+		Count
+	};
+
+	constexpr size_t KERNEL_COUNT = static_cast<size_t>(Kernel::Count);
+
+	// bucket i counts calls with limbs in [2^(i - 1), 2^i), bucket 0 counts empty inputs
+	constexpr size_t HISTOGRAM_BUCKETS = 48;
+
+	struct KernelStats
+	{
+		std::uint64_t calls;
+		std::uint64_t limbs;
+		std::uint64_t cycles;
+		std::uint64_t limbHistogram[HISTOGRAM_BUCKETS];
+	};
+
+	struct Snapshot
+	{
+		KernelStats kernels[KERNEL_COUNT];
+		std::uint64_t allocations;
+		std::uint64_t allocatedBytes;
+
+		std::string ToText() const;
+		std::string ToJson() const;
+	};
+
+	constexpr bool IsEnabled()
+	{
+#if defined(BIGINTEGER_INSTRUMENTATION)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	const char* GetKernelName(Kernel kernel);
+
+	Snapshot TakeSnapshot();
+	void Reset();
+
+	std::uint64_t ReadCycles();
+	void RecordKernel(Kernel kernel, size_t limbs, std::uint64_t cycles);
+	void RecordAllocation(size_t bytes);
+
+	class ScopedKernel
+	{
+	private:
+		Kernel m_kernel;
+		size_t m_limbs;
+		std::uint64_t m_start;
+
+	public:
+		ScopedKernel(Kernel kernel, size_t limbs)
+			: m_kernel{ kernel }, m_limbs{ limbs }, m_start{ ReadCycles() }
+		{
+
+		}
+
+		ScopedKernel(const ScopedKernel& other) = delete;
+		ScopedKernel& operator=(const ScopedKernel& other) = delete;
+
+		~ScopedKernel()
+		{
+			RecordKernel(m_kernel, m_limbs, ReadCycles() - m_start);
+		}
+	};
+
+	// std::allocator that reports every allocation, used for the limb vectors when instrumented
+	template <typename T>
+	struct CountingAllocator
+	{
+		using value_type = T;
+
+		CountingAllocator() = default;
+
+		template <typename U>
+		CountingAllocator(const CountingAllocator<U>&) noexcept
+		{
+
+		}
+
+		T* allocate(size_t count)
+		{
+			RecordAllocation(count * sizeof(T));
+
+			return std::allocator<T>{}.allocate(count);
+		}
+
+		void deallocate(T* pointer, size_t count) noexcept
+		{
+			std::allocator<T>{}.deallocate(pointer, count);
+		}
+
+		template <typename U>
+		bool operator==(const CountingAllocator<U>&) const noexcept
+		{
+			return true;
+		}
+	};
+}
+
+#if defined(BIGINTEGER_INSTRUMENTATION)
+#define BIGINTEGER_PROFILE_KERNEL(kernel, limbs) \
+	const BigIntegerProfiler::ScopedKernel bigIntegerProfilerScope{ BigIntegerProfiler::Kernel::kernel, static_cast<size_t>(limbs) }
+#else
+#define BIGINTEGER_PROFILE_KERNEL(kernel, limbs) ((void)0)
+#endif
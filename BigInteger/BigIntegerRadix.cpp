@@ -0,0 +1,201 @@
+#include "BigIntegerRadix.h"
+
+#include <bit>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+#include "BigIntegerLimbs.h"
+#include "BigIntegerThresholds.h"
+
+namespace
+{
+	using BigIntegerLimbs::BASE;
+	using BigIntegerLimbs::WORD_BASE;
+
+	void NormalizeWords(std::vector<std::uint32_t>& words)
+	{
+		while (words.size() > 1 && words.back() == 0)
+		{
+			words.pop_back();
+		}
+
+		if (words.empty())
+		{
+			words.push_back(0);
+		}
+	}
+
+	std::vector<std::uint32_t> MultiplyWords(std::span<const std::uint32_t> a, std::span<const std::uint32_t> b)
+	{
+		std::vector<std::uint32_t> out(a.size() + b.size());
+
+		out.resize(BigIntegerLimbs::Multiply<WORD_BASE>(a, b, out));
+
+		return out;
+	}
+
+	// a += b, a has to be at least as long as b
+	void AddWords(std::vector<std::uint32_t>& a, std::span<const std::uint32_t> b)
+	{
+		std::uint64_t carry = 0;
+
+		for (size_t i = 0; i < a.size() && (i < b.size() || carry > 0); ++i)
+		{
+			const std::uint64_t sum = static_cast<std::uint64_t>(a[i]) + (i < b.size() ? b[i] : 0) + carry;
+
+			a[i] = static_cast<std::uint32_t>(sum);
+			carry = sum >> 32;
+		}
+
+		if (carry > 0)
+		{
+			a.push_back(static_cast<std::uint32_t>(carry));
+		}
+	}
+
+	// powers at level i are 2^(32 * 2^i) in limbs and 10^(9 * 2^i) in words, built on first use and kept
+	class PowerTable
+	{
+	private:
+		std::deque<BigInteger> m_powersOfTwo;
+		std::deque<std::vector<std::uint32_t>> m_powersOfTen;
+		std::mutex m_mutex;
+
+	public:
+		const BigInteger& GetPowerOfTwo(size_t level)
+		{
+			const std::lock_guard<std::mutex> lock{ m_mutex };
+
+			if (m_powersOfTwo.empty())
+			{
+				m_powersOfTwo.emplace_back(WORD_BASE);
+			}
+
+			while (m_powersOfTwo.size() <= level)
+			{
+				m_powersOfTwo.push_back(m_powersOfTwo.back() * m_powersOfTwo.back());
+			}
+
+			// deque elements stay in place when it grows
+			return m_powersOfTwo[level];
+		}
+
+		const std::vector<std::uint32_t>& GetPowerOfTen(size_t level)
+		{
+			const std::lock_guard<std::mutex> lock{ m_mutex };
+
+			if (m_powersOfTen.empty())
+			{
+				m_powersOfTen.push_back({ static_cast<std::uint32_t>(BASE) });
+			}
+
+			while (m_powersOfTen.size() <= level)
+			{
+				m_powersOfTen.push_back(MultiplyWords(m_powersOfTen.back(), m_powersOfTen.back()));
+			}
+
+			return m_powersOfTen[level];
+		}
+	};
+
+	PowerTable& GetPowerTable()
+	{
+		static PowerTable table;
+
+		return table;
+	}
+
+	BigInteger ConvertFromWords(std::span<const std::uint32_t> words)
+	{
+		const size_t size = BigIntegerLimbs::GetNormalizedSize(words);
+
+		if (size <= BigIntegerTuning::GetThresholds().radixBasecaseLimbs)
+		{
+			BigInteger result;
+
+			for (size_t i = size; i > 0; --i)
+			{
+				result *= WORD_BASE;
+				result += words[i - 1];
+			}
+
+			return result;
+		}
+
+		// low half of k words, k the largest power of two below size
+		const size_t level = std::bit_width(size - 1) - 1;
+		const size_t half = size_t{ 1 } << level;
+
+		BigInteger result = ConvertFromWords(words.subspan(half, size - half));
+
+		result *= GetPowerTable().GetPowerOfTwo(level);
+		result += ConvertFromWords(words.first(half));
+
+		return result;
+	}
+
+	std::vector<std::uint32_t> ConvertToWords(std::span<const std::uint32_t> limbs)
+	{
+		const size_t size = BigIntegerLimbs::GetNormalizedSize(limbs);
+
+		if (size <= BigIntegerTuning::GetThresholds().radixBasecaseLimbs)
+		{
+			std::vector<std::uint32_t> words;
+
+			for (size_t i = size; i > 0; --i)
+			{
+				std::uint64_t carry = limbs[i - 1];
+
+				for (std::uint32_t& word : words)
+				{
+					const std::uint64_t value = word * BASE + carry;
+
+					word = static_cast<std::uint32_t>(value);
+					carry = value >> 32;
+				}
+
+				if (carry > 0)
+				{
+					words.push_back(static_cast<std::uint32_t>(carry));
+				}
+			}
+
+			NormalizeWords(words);
+
+			return words;
+		}
+
+		const size_t level = std::bit_width(size - 1) - 1;
+		const size_t half = size_t{ 1 } << level;
+
+		const std::vector<std::uint32_t> high = ConvertToWords(limbs.subspan(half, size - half));
+		const std::vector<std::uint32_t> low = ConvertToWords(limbs.first(half));
+
+		std::vector<std::uint32_t> words = MultiplyWords(high, GetPowerTable().GetPowerOfTen(level));
+
+		AddWords(words, low);
+
+		return words;
+	}
+}
+
+namespace BigIntegerRadix
+{
+	BigInteger FromWords(std::span<const std::uint32_t> words, bool isNegative)
+	{
+		BigInteger result = ConvertFromWords(words);
+
+		if (isNegative)
+		{
+			return -std::move(result);
+		}
+
+		return result;
+	}
+
+	std::vector<std::uint32_t> ToWords(std::span<const std::uint32_t> limbs)
+	{
+		return ConvertToWords(limbs);
+	}
+}
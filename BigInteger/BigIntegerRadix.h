@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "BigInteger.h"
+
+// Conversion between base 10^9 limbs and base 2^32 words, both least significant first.
+// Each direction splits its input in halves around a cached power of the other base and joins the
+// converted halves with one multiplication, so a conversion costs about M(n) log n.
+namespace BigIntegerRadix
+{
+	// words may have leading zero words
+	BigInteger FromWords(std::span<const std::uint32_t> words, bool isNegative);
+
+	// limbs of a magnitude, the result has no leading zero words and zero is a single 0 word
+	std::vector<std::uint32_t> ToWords(std::span<const std::uint32_t> limbs);
+}
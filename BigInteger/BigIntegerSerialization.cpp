@@ -0,0 +1,336 @@
+#include "BigIntegerSerialization.h"
+
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+#include "BigIntegerLimbs.h"
+
+namespace
+{
+	constexpr std::uint8_t VALUE_MAGIC[4]{ 'B', 'I', 'G', 'I' };
+	constexpr std::uint8_t ARRAY_MAGIC[4]{ 'B', 'I', 'G', 'A' };
+	constexpr std::uint16_t FLAG_NEGATIVE = 1;
+	constexpr size_t RECORD_ALIGNMENT = 8;
+
+	void WriteLittleEndian(std::uint8_t* out, std::uint64_t value, size_t size)
+	{
+		for (size_t i = 0; i < size; ++i)
+		{
+			out[i] = static_cast<std::uint8_t>(value >> (i * 8));
+		}
+	}
+
+	std::uint64_t ReadLittleEndian(const std::uint8_t* in, size_t size)
+	{
+		std::uint64_t value = 0;
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			value |= static_cast<std::uint64_t>(in[i]) << (i * 8);
+		}
+
+		return value;
+	}
+
+	// checks the header and the record bounds, stores the limb count and the sign
+	bool ReadValueHeader(std::span<const std::uint8_t> bytes, std::uint64_t& limbCount, bool& isNegative)
+	{
+		if (bytes.size() < BigIntegerSerialization::VALUE_HEADER_SIZE
+			|| std::memcmp(bytes.data(), VALUE_MAGIC, sizeof(VALUE_MAGIC)) != 0
+			|| ReadLittleEndian(bytes.data() + 4, 2) != BigIntegerSerialization::VERSION)
+		{
+			return false;
+		}
+
+		const std::uint64_t flags = ReadLittleEndian(bytes.data() + 6, 2);
+
+		limbCount = ReadLittleEndian(bytes.data() + 8, 8);
+		isNegative = (flags & FLAG_NEGATIVE) != 0;
+
+		if ((flags & ~static_cast<std::uint64_t>(FLAG_NEGATIVE)) != 0 || limbCount == 0
+			|| limbCount > (bytes.size() - BigIntegerSerialization::VALUE_HEADER_SIZE) / sizeof(std::uint32_t))
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	bool IsCanonical(std::span<const std::uint32_t> digits, bool isNegative)
+	{
+		const size_t size = digits.size();
+
+		if ((size > 1 && digits[size - 1] == 0) || (isNegative && size == 1 && digits[0] == 0))
+		{
+			return false;
+		}
+
+		for (const std::uint32_t digit : digits)
+		{
+			if (digit >= BigIntegerLimbs::BASE)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+namespace BigIntegerSerialization
+{
+	void WriteValueHeader(std::uint8_t* out, size_t limbCount, bool isNegative)
+	{
+		std::memcpy(out, VALUE_MAGIC, sizeof(VALUE_MAGIC));
+		WriteLittleEndian(out + 4, VERSION, 2);
+		WriteLittleEndian(out + 6, isNegative ? FLAG_NEGATIVE : 0, 2);
+		WriteLittleEndian(out + 8, limbCount, 8);
+	}
+
+	void Serialize(const BigIntegerView& number, std::vector<std::uint8_t>& out)
+	{
+		const std::span<const std::uint32_t> digits = number.GetDigits();
+		const size_t start = out.size();
+
+		out.resize(start + VALUE_HEADER_SIZE + digits.size() * sizeof(std::uint32_t));
+
+		std::uint8_t* header = out.data() + start;
+
+		WriteValueHeader(header, digits.size(), number.IsNegative());
+
+		std::uint8_t* limbs = header + VALUE_HEADER_SIZE;
+
+		if constexpr (std::endian::native == std::endian::little)
+		{
+			std::memcpy(limbs, digits.data(), digits.size() * sizeof(std::uint32_t));
+		}
+		else
+		{
+			for (size_t i = 0; i < digits.size(); ++i)
+			{
+				WriteLittleEndian(limbs + i * sizeof(std::uint32_t), digits[i], sizeof(std::uint32_t));
+			}
+		}
+	}
+
+	bool Deserialize(std::span<const std::uint8_t> bytes, BigInteger& number, size_t& size)
+	{
+		std::uint64_t limbCount = 0;
+		bool isNegative = false;
+
+		if (!ReadValueHeader(bytes, limbCount, isNegative))
+		{
+			assert(false);
+
+			return false;
+		}
+
+		const std::uint8_t* limbs = bytes.data() + VALUE_HEADER_SIZE;
+		const bool isInPlace = std::endian::native == std::endian::little
+			&& reinterpret_cast<std::uintptr_t>(limbs) % alignof(std::uint32_t) == 0;
+
+		// unaligned or big-endian input goes through a copy, otherwise the limbs are read where they are
+		std::vector<std::uint32_t> buffer;
+		std::span<const std::uint32_t> digits;
+
+		if (isInPlace)
+		{
+			digits = { reinterpret_cast<const std::uint32_t*>(limbs), static_cast<size_t>(limbCount) };
+		}
+		else
+		{
+			buffer.resize(static_cast<size_t>(limbCount));
+
+			for (size_t i = 0; i < buffer.size(); ++i)
+			{
+				buffer[i] = static_cast<std::uint32_t>(ReadLittleEndian(limbs + i * sizeof(std::uint32_t), sizeof(std::uint32_t)));
+			}
+
+			digits = buffer;
+		}
+
+		if (!IsCanonical(digits, isNegative))
+		{
+			assert(false);
+
+			return false;
+		}
+
+		number = BigInteger{ BigIntegerView{ digits, isNegative } };
+		size = VALUE_HEADER_SIZE + static_cast<size_t>(limbCount) * sizeof(std::uint32_t);
+
+		return true;
+	}
+
+	bool DeserializeView(std::span<const std::uint8_t> bytes, BigIntegerView& view, size_t& size)
+	{
+		std::uint64_t limbCount = 0;
+		bool isNegative = false;
+
+		if (!ReadValueHeader(bytes, limbCount, isNegative))
+		{
+			assert(false);
+
+			return false;
+		}
+
+		const std::uint8_t* limbs = bytes.data() + VALUE_HEADER_SIZE;
+
+		if (std::endian::native != std::endian::little
+			|| reinterpret_cast<std::uintptr_t>(limbs) % alignof(std::uint32_t) != 0)
+		{
+			assert(false);
+
+			return false;
+		}
+
+		const std::span<const std::uint32_t> digits{ reinterpret_cast<const std::uint32_t*>(limbs), static_cast<size_t>(limbCount) };
+		const std::uint32_t top = digits.back();
+
+		// a full scan would turn the load back into a pass over the data, so only the invariants the view relies on are checked
+		if ((digits.size() > 1 && top == 0) || top >= BigIntegerLimbs::BASE || (isNegative && digits.size() == 1 && top == 0))
+		{
+			assert(false);
+
+			return false;
+		}
+
+		view = BigIntegerView{ digits, isNegative };
+		size = VALUE_HEADER_SIZE + static_cast<size_t>(limbCount) * sizeof(std::uint32_t);
+
+		return true;
+	}
+}
+
+BigIntegerArrayWriter::BigIntegerArrayWriter(std::ostream& output)
+	: m_output{ output }, m_start{ output.tellp() }, m_size{ BigIntegerSerialization::ARRAY_HEADER_SIZE }
+{
+	const std::uint8_t header[BigIntegerSerialization::ARRAY_HEADER_SIZE]{};
+
+	m_output.write(reinterpret_cast<const char*>(header), sizeof(header));
+}
+
+void BigIntegerArrayWriter::Append(const BigIntegerView& number)
+{
+	m_buffer.clear();
+	BigIntegerSerialization::Serialize(number, m_buffer);
+
+	// padding keeps every record 8-byte aligned when the file is mapped
+	m_buffer.resize((m_buffer.size() + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT, 0);
+
+	m_offsets.push_back(m_size);
+	m_output.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+	m_size += m_buffer.size();
+}
+
+size_t BigIntegerArrayWriter::GetCount() const
+{
+	return m_offsets.size();
+}
+
+bool BigIntegerArrayWriter::Finish()
+{
+	const std::uint64_t indexOffset = m_size;
+
+	m_buffer.resize(m_offsets.size() * sizeof(std::uint64_t));
+
+	for (size_t i = 0; i < m_offsets.size(); ++i)
+	{
+		WriteLittleEndian(m_buffer.data() + i * sizeof(std::uint64_t), m_offsets[i], sizeof(std::uint64_t));
+	}
+
+	m_output.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+	m_size += m_buffer.size();
+
+	std::uint8_t header[BigIntegerSerialization::ARRAY_HEADER_SIZE]{};
+
+	std::memcpy(header, ARRAY_MAGIC, sizeof(ARRAY_MAGIC));
+	WriteLittleEndian(header + 4, BigIntegerSerialization::VERSION, 2);
+	WriteLittleEndian(header + 8, m_offsets.size(), 8);
+	WriteLittleEndian(header + 16, indexOffset, 8);
+	WriteLittleEndian(header + 24, m_size, 8);
+
+	const std::streamoff end = m_start + static_cast<std::streamoff>(m_size);
+
+	m_output.seekp(m_start);
+	m_output.write(reinterpret_cast<const char*>(header), sizeof(header));
+	m_output.seekp(end);
+	m_output.flush();
+
+	return m_output.good();
+}
+
+BigIntegerArrayView::BigIntegerArrayView()
+	: m_count{ 0 }, m_indexOffset{ 0 }
+{
+
+}
+
+bool BigIntegerArrayView::Open(std::span<const std::uint8_t> bytes)
+{
+	m_bytes = {};
+	m_count = 0;
+	m_indexOffset = 0;
+
+	if (bytes.size() < BigIntegerSerialization::ARRAY_HEADER_SIZE
+		|| std::memcmp(bytes.data(), ARRAY_MAGIC, sizeof(ARRAY_MAGIC)) != 0
+		|| ReadLittleEndian(bytes.data() + 4, 2) != BigIntegerSerialization::VERSION)
+	{
+		assert(false);
+
+		return false;
+	}
+
+	const std::uint64_t count = ReadLittleEndian(bytes.data() + 8, 8);
+	const std::uint64_t indexOffset = ReadLittleEndian(bytes.data() + 16, 8);
+	const std::uint64_t size = ReadLittleEndian(bytes.data() + 24, 8);
+
+	if (size > bytes.size() || indexOffset < BigIntegerSerialization::ARRAY_HEADER_SIZE || indexOffset > size
+		|| count > (size - indexOffset) / sizeof(std::uint64_t))
+	{
+		assert(false);
+
+		return false;
+	}
+
+	m_bytes = bytes.first(static_cast<size_t>(size));
+	m_count = count;
+	m_indexOffset = indexOffset;
+
+	return true;
+}
+
+size_t BigIntegerArrayView::GetCount() const
+{
+	return static_cast<size_t>(m_count);
+}
+
+BigIntegerView BigIntegerArrayView::Get(size_t index) const
+{
+	if (index >= m_count)
+	{
+		assert(false);
+
+		return BigIntegerView{};
+	}
+
+	const std::uint64_t offset = ReadLittleEndian(m_bytes.data() + m_indexOffset + index * sizeof(std::uint64_t), sizeof(std::uint64_t));
+
+	if (offset < BigIntegerSerialization::ARRAY_HEADER_SIZE || offset >= m_indexOffset)
+	{
+		assert(false);
+
+		return BigIntegerView{};
+	}
+
+	// records end before the index
+	const std::span<const std::uint8_t> record = m_bytes.subspan(static_cast<size_t>(offset), static_cast<size_t>(m_indexOffset - offset));
+
+	BigIntegerView view;
+	size_t size = 0;
+
+	BigIntegerSerialization::DeserializeView(record, view, size);
+
+	return view;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "BigInteger.h"
+#include "BigIntegerView.h"
+
+// Binary format, every field little-endian.
+//
+// value record, 16 byte header then the limbs:
+//   "BIGI", u16 version, u16 flags (bit 0 = negative), u64 limb count, u32 limbs least significant first
+//
+// array of values:
+//   "BIGA", u16 version, u16 reserved, u64 count, u64 index offset, u64 total size,
+//   then the value records each padded to 8 bytes, then count u64 record offsets.
+//   Offsets are from the start of the array, so a mapped array is read in place.
+namespace BigIntegerSerialization
+{
+	constexpr std::uint16_t VERSION = 1;
+	constexpr size_t VALUE_HEADER_SIZE = 16;
+	constexpr size_t ARRAY_HEADER_SIZE = 32;
+
+	// writes the 16 byte header of a value record, for writers that produce the limbs in place
+	void WriteValueHeader(std::uint8_t* out, size_t limbCount, bool isNegative);
+
+	// appends one value record to out
+	void Serialize(const BigIntegerView& number, std::vector<std::uint8_t>& out);
+
+	// reads the record at the start of bytes and stores its size, return false when it is malformed
+	bool Deserialize(std::span<const std::uint8_t> bytes, BigInteger& number, size_t& size);
+
+	// zero-copy, the view points into bytes. Only the header and the top limb are checked, and the limbs
+	// have to be 4-byte aligned on a little-endian host.
+	bool DeserializeView(std::span<const std::uint8_t> bytes, BigIntegerView& view, size_t& size);
+}
+
+// Streams an array of values to a seekable output, the header is patched by Finish().
+class BigIntegerArrayWriter
+{
+private:
+	std::ostream& m_output;
+	std::streamoff m_start;
+	std::uint64_t m_size;
+	std::vector<std::uint64_t> m_offsets;
+	std::vector<std::uint8_t> m_buffer;
+
+public:
+	explicit BigIntegerArrayWriter(std::ostream& output);
+	BigIntegerArrayWriter(const BigIntegerArrayWriter& other) = delete;
+	BigIntegerArrayWriter& operator=(const BigIntegerArrayWriter& other) = delete;
+
+public:
+	void Append(const BigIntegerView& number);
+	size_t GetCount() const;
+
+	// writes the index and the header, return false when the output failed
+	bool Finish();
+};
+
+// Reads an array of values in place, typically from a BigIntegerMappedFile.
+class BigIntegerArrayView
+{
+private:
+	std::span<const std::uint8_t> m_bytes;
+	std::uint64_t m_count;
+	std::uint64_t m_indexOffset;
+
+public:
+	BigIntegerArrayView();
+
+	// checks the header and the index bounds, the records are checked when they are read
+	bool Open(std::span<const std::uint8_t> bytes);
+
+	size_t GetCount() const;
+	BigIntegerView Get(size_t index) const;
+};
@@ -0,0 +1,583 @@
+#include "BigIntegerShardPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include "BigIntegerLimbs.h"
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	constexpr std::uint32_t BASE = 1000000000;
+
+	// limbs [begin, begin + size) of digits as a value, the piece may be empty or have zeros on top
+	BigInteger GetPiece(std::span<const std::uint32_t> digits, size_t begin, size_t size)
+	{
+		if (begin >= digits.size())
+		{
+			return BigInteger{};
+		}
+
+		const std::span<const std::uint32_t> piece = digits.subspan(begin, std::min(size, digits.size() - begin));
+
+		return BigInteger{ BigIntegerView{ piece.first(BigIntegerLimbs::GetNormalizedSize(piece)), false } };
+	}
+
+	// |value| as x0 + x1 * X + x2 * X^2 with X = BASE^pieceSize, evaluated at 0, 1, -1, -2 and infinity
+	void Evaluate(const BigInteger& value, size_t pieceSize, BigInteger (&points)[BigIntegerShardPool::TASK_COUNT])
+	{
+		const std::span<const std::uint32_t> digits = value.GetView().GetDigits();
+		const BigInteger x0 = GetPiece(digits, 0, pieceSize);
+		const BigInteger x1 = GetPiece(digits, pieceSize, pieceSize);
+		const BigInteger x2 = GetPiece(digits, 2 * pieceSize, pieceSize);
+		const BigInteger sum02 = x0 + x2;
+
+		points[0] = x0;
+		points[1] = sum02 + x1;
+		points[2] = sum02 - x1;
+		points[3] = (points[2] + x2) * 2 - x0;
+		points[4] = x2;
+	}
+
+	// result += value * BASE^shift for a value that is not negative
+	void AddShifted(std::vector<std::uint32_t>& result, const BigInteger& value, size_t shift)
+	{
+		assert(!value.GetView().IsNegative());
+
+		const std::span<const std::uint32_t> digits = value.GetView().GetDigits();
+		std::uint32_t carry = 0;
+		size_t i = 0;
+
+		for (; i < digits.size(); ++i)
+		{
+			const std::uint32_t sum = result[shift + i] + digits[i] + carry;
+
+			carry = sum >= BASE ? 1 : 0;
+			result[shift + i] = sum - carry * BASE;
+		}
+
+		// the coefficients add up to the product, so the carry stops inside the result
+		for (; carry > 0; ++i)
+		{
+			assert(shift + i < result.size());
+
+			const std::uint32_t sum = result[shift + i] + carry;
+
+			carry = sum >= BASE ? 1 : 0;
+			result[shift + i] = sum - carry * BASE;
+		}
+	}
+
+#if !defined(_WIN32)
+	// one product for a worker, offsets and sizes count limbs of the segment
+	struct ShardTask
+	{
+		char segment[64];
+		std::uint64_t segmentLimbs;
+		// the Multiply call the task belongs to, answers to an abandoned call are dropped
+		std::uint64_t call;
+		std::uint64_t task;
+		std::uint64_t leftOffset;
+		std::uint64_t leftSize;
+		std::uint64_t rightOffset;
+		std::uint64_t rightSize;
+		std::uint64_t outOffset;
+	};
+
+	// size is the normalized size of the product, 0 when the worker failed
+	struct ShardDone
+	{
+		std::uint64_t call;
+		std::uint64_t task;
+		std::uint64_t size;
+	};
+
+	// how long the coordinator waits for an answer before it checks whether a worker died
+	constexpr int WORKER_CHECK_MS = 100;
+
+	// several workers read one pipe, messages within PIPE_BUF are never split or interleaved
+	static_assert(sizeof(ShardTask) <= PIPE_BUF);
+
+	bool ReadAll(int file, void* data, size_t size)
+	{
+		std::uint8_t* bytes = static_cast<std::uint8_t*>(data);
+
+		while (size > 0)
+		{
+			const ssize_t count = read(file, bytes, size);
+
+			if (count < 0 && errno == EINTR)
+			{
+				continue;
+			}
+
+			if (count <= 0)
+			{
+				return false;
+			}
+
+			bytes += count;
+			size -= static_cast<size_t>(count);
+		}
+
+		return true;
+	}
+
+	bool WriteAll(int file, const void* data, size_t size)
+	{
+		const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+
+		while (size > 0)
+		{
+			const ssize_t count = write(file, bytes, size);
+
+			if (count < 0 && errno == EINTR)
+			{
+				continue;
+			}
+
+			if (count <= 0)
+			{
+				return false;
+			}
+
+			bytes += count;
+			size -= static_cast<size_t>(count);
+		}
+
+		return true;
+	}
+
+	// holds SIGPIPE for the calling thread, so writing to a pipe whose readers are gone fails with EPIPE
+	// instead of killing the process. A SIGPIPE raised meanwhile is taken off before the mask is restored.
+	class SigpipeBlock
+	{
+	private:
+		sigset_t m_sigpipe;
+		sigset_t m_previous;
+		bool m_wasPending;
+
+	public:
+		SigpipeBlock()
+		{
+			sigemptyset(&m_sigpipe);
+			sigaddset(&m_sigpipe, SIGPIPE);
+			pthread_sigmask(SIG_BLOCK, &m_sigpipe, &m_previous);
+
+			sigset_t pending;
+
+			sigpending(&pending);
+			m_wasPending = sigismember(&pending, SIGPIPE) == 1;
+		}
+
+		~SigpipeBlock()
+		{
+			sigset_t pending;
+
+			sigpending(&pending);
+
+			if (!m_wasPending && sigismember(&pending, SIGPIPE) == 1)
+			{
+				int signal = 0;
+
+				sigwait(&m_sigpipe, &signal);
+			}
+
+			pthread_sigmask(SIG_SETMASK, &m_previous, nullptr);
+		}
+
+		SigpipeBlock(const SigpipeBlock& other) = delete;
+		SigpipeBlock& operator=(const SigpipeBlock& other) = delete;
+	};
+#endif
+}
+
+#if defined(_WIN32)
+BigIntegerShardPool::BigIntegerShardPool(size_t, std::span<const int>)
+	: m_taskPipe{ -1, -1 }, m_donePipe{ -1, -1 }, m_segmentCount{ 0 }
+{
+
+}
+#else
+BigIntegerShardPool::BigIntegerShardPool(size_t workerCount, std::span<const int> cpus)
+	: m_taskPipe{ -1, -1 }, m_donePipe{ -1, -1 }, m_segmentCount{ 0 }
+{
+	if (pipe(m_taskPipe) != 0 || pipe(m_donePipe) != 0)
+	{
+		Stop();
+
+		return;
+	}
+
+	for (size_t i = 0; i < workerCount; ++i)
+	{
+		const pid_t pid = fork();
+
+		if (pid < 0)
+		{
+			break;
+		}
+
+		if (pid == 0)
+		{
+			// the worker keeps only the task reading end and the done writing end
+			close(m_taskPipe[1]);
+			close(m_donePipe[0]);
+
+#if defined(__linux__)
+			if (!cpus.empty())
+			{
+				cpu_set_t set;
+
+				CPU_ZERO(&set);
+				CPU_SET(cpus[i % cpus.size()], &set);
+				sched_setaffinity(0, sizeof(set), &set);
+			}
+#endif
+
+			RunWorker(m_taskPipe[0], m_donePipe[1]);
+
+			// no destructors or stdio flushes of the coordinator's state
+			_exit(0);
+		}
+
+		m_workers.push_back(static_cast<int>(pid));
+	}
+
+#if !defined(__linux__)
+	static_cast<void>(cpus);
+#endif
+
+	if (m_workers.empty())
+	{
+		Stop();
+
+		return;
+	}
+
+	// with the coordinator's copies closed, the workers see the end of the tasks once m_taskPipe[1] closes
+	close(m_taskPipe[0]);
+	close(m_donePipe[1]);
+	m_taskPipe[0] = -1;
+	m_donePipe[1] = -1;
+}
+#endif
+
+BigIntegerShardPool::~BigIntegerShardPool()
+{
+	Stop();
+}
+
+bool BigIntegerShardPool::IsRunning() const
+{
+	return !m_workers.empty();
+}
+
+size_t BigIntegerShardPool::GetWorkerCount() const
+{
+	return m_workers.size();
+}
+
+BigInteger BigIntegerShardPool::Multiply(const BigInteger& a, const BigInteger& b)
+{
+	const size_t aSize = a.GetView().GetDigits().size();
+	const size_t bSize = b.GetView().GetDigits().size();
+	const size_t pieceSize = (std::max(aSize, bSize) + 2) / 3;
+
+	// a shorter operand within one piece would leave Toom-3 nothing to split
+	if (!IsRunning() || std::min(aSize, bSize) < MIN_SHARD_LIMBS || std::min(aSize, bSize) <= pieceSize)
+	{
+		return a * b;
+	}
+
+	BigInteger left[TASK_COUNT];
+	BigInteger right[TASK_COUNT];
+	BigInteger products[TASK_COUNT];
+
+	Evaluate(a, pieceSize, left);
+	Evaluate(b, pieceSize, right);
+
+	bool isReceived[TASK_COUNT]{};
+
+	MultiplyRemote(left, right, products, isReceived);
+
+	// a worker failed or died, or the segment could not be created, the missing products are made here
+	for (size_t i = 0; i < TASK_COUNT; ++i)
+	{
+		if (!isReceived[i])
+		{
+			products[i] = left[i] * right[i];
+		}
+	}
+
+	// Bodrato's interpolation sequence for the points 0, 1, -1, -2 and infinity, every division is exact
+	BigInteger r3 = BigInteger::DivExact(products[3] - products[1], 3);
+	BigInteger r1 = BigInteger::DivExact(products[1] - products[2], 2);
+	BigInteger r2 = products[2] - products[0];
+
+	r3 = BigInteger::DivExact(r2 - r3, 2) + products[4] * 2;
+	r2 = r2 + r1 - products[4];
+	r1 = r1 - r3;
+
+	std::vector<std::uint32_t> result(aSize + bSize, 0);
+
+	AddShifted(result, products[0], 0);
+	AddShifted(result, r1, pieceSize);
+	AddShifted(result, r2, 2 * pieceSize);
+	AddShifted(result, r3, 3 * pieceSize);
+	AddShifted(result, products[4], 4 * pieceSize);
+
+	const std::span<const std::uint32_t> digits{ result.data(), BigIntegerLimbs::GetNormalizedSize(result) };
+
+	// neither operand is zero, so neither is the product
+	return BigInteger{ BigIntegerView{ digits, a.GetView().IsNegative() != b.GetView().IsNegative() } };
+}
+
+#if defined(_WIN32)
+void BigIntegerShardPool::MultiplyRemote(std::span<const BigInteger>, std::span<const BigInteger>, std::span<BigInteger>, std::span<bool>)
+{
+
+}
+
+bool BigIntegerShardPool::ReapWorkers()
+{
+	return false;
+}
+
+void BigIntegerShardPool::RunWorker(int, int)
+{
+
+}
+
+void BigIntegerShardPool::Stop()
+{
+
+}
+#else
+void BigIntegerShardPool::MultiplyRemote(std::span<const BigInteger> left, std::span<const BigInteger> right, std::span<BigInteger> products,
+	std::span<bool> isReceived)
+{
+	// each task takes its two operands and room for their product, one after another
+	ShardTask tasks[TASK_COUNT]{};
+	size_t limbs = 0;
+	const std::uint64_t call = ++m_segmentCount;
+
+	for (size_t i = 0; i < TASK_COUNT; ++i)
+	{
+		ShardTask& task = tasks[i];
+
+		task.call = call;
+		task.task = i;
+		task.leftOffset = limbs;
+		task.leftSize = left[i].GetView().GetDigits().size();
+		limbs += task.leftSize;
+		task.rightOffset = limbs;
+		task.rightSize = right[i].GetView().GetDigits().size();
+		limbs += task.rightSize;
+		task.outOffset = limbs;
+		limbs += task.leftSize + task.rightSize;
+	}
+
+	char segment[sizeof(ShardTask::segment)];
+
+	std::snprintf(segment, sizeof(segment), "/biginteger-%d-%llu", static_cast<int>(getpid()), static_cast<unsigned long long>(call));
+
+	const int file = shm_open(segment, O_CREAT | O_EXCL | O_RDWR, 0600);
+
+	if (file < 0)
+	{
+		return;
+	}
+
+	const size_t bytes = limbs * sizeof(std::uint32_t);
+	void* data = ftruncate(file, static_cast<off_t>(bytes)) == 0 ? mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0) : MAP_FAILED;
+
+	close(file);
+
+	if (data == MAP_FAILED)
+	{
+		shm_unlink(segment);
+
+		return;
+	}
+
+	std::uint32_t* segmentLimbs = static_cast<std::uint32_t*>(data);
+	size_t sent = 0;
+
+	{
+		const SigpipeBlock sigpipeBlock;
+
+		for (; sent < TASK_COUNT; ++sent)
+		{
+			ShardTask& task = tasks[sent];
+			const std::span<const std::uint32_t> leftDigits = left[sent].GetView().GetDigits();
+			const std::span<const std::uint32_t> rightDigits = right[sent].GetView().GetDigits();
+
+			std::copy(leftDigits.begin(), leftDigits.end(), segmentLimbs + task.leftOffset);
+			std::copy(rightDigits.begin(), rightDigits.end(), segmentLimbs + task.rightOffset);
+			std::memcpy(task.segment, segment, sizeof(segment));
+			task.segmentLimbs = limbs;
+
+			if (!WriteAll(m_taskPipe[1], &task, sizeof(task)))
+			{
+				break;
+			}
+		}
+	}
+
+	// the task pipe breaks when no worker reads it any more
+	if (sent < TASK_COUNT)
+	{
+		ReapWorkers();
+	}
+
+	// waits for the tasks that went out until one fails or a worker dies. A dead worker may have taken
+	// any of them, so the rest are left to the caller, and late answers carry an old call and are dropped.
+	size_t answered = 0;
+
+	while (answered < sent && IsRunning())
+	{
+		pollfd done{ m_donePipe[0], POLLIN, 0 };
+		const int ready = poll(&done, 1, WORKER_CHECK_MS);
+
+		if (ready < 0 && errno == EINTR)
+		{
+			continue;
+		}
+
+		if (ready == 0)
+		{
+			if (ReapWorkers())
+			{
+				break;
+			}
+
+			continue;
+		}
+
+		ShardDone answer;
+
+		if (ready < 0 || !ReadAll(m_donePipe[0], &answer, sizeof(answer)))
+		{
+			// every worker is gone
+			Stop();
+
+			break;
+		}
+
+		if (answer.call != call)
+		{
+			continue;
+		}
+
+		++answered;
+
+		if (answer.task >= TASK_COUNT || answer.size == 0)
+		{
+			break;
+		}
+
+		const ShardTask& task = tasks[answer.task];
+		const std::span<const std::uint32_t> digits{ segmentLimbs + task.outOffset, static_cast<size_t>(answer.size) };
+		const bool isZero = digits.size() == 1 && digits[0] == 0;
+
+		products[answer.task] = BigInteger{ BigIntegerView{ digits, !isZero && left[answer.task].GetView().IsNegative() != right[answer.task].GetView().IsNegative() } };
+		isReceived[answer.task] = true;
+	}
+
+	// workers still holding a task keep their own mapping, the name goes away either way
+	munmap(data, bytes);
+	shm_unlink(segment);
+}
+
+bool BigIntegerShardPool::ReapWorkers()
+{
+	const size_t workerCount = m_workers.size();
+
+	std::erase_if(m_workers, [](int worker)
+		{
+			return waitpid(static_cast<pid_t>(worker), nullptr, WNOHANG) != 0;
+		});
+
+	if (m_workers.empty())
+	{
+		Stop();
+	}
+
+	return m_workers.size() != workerCount;
+}
+
+void BigIntegerShardPool::RunWorker(int taskPipe, int donePipe)
+{
+	ShardTask task;
+
+	while (ReadAll(taskPipe, &task, sizeof(task)))
+	{
+		ShardDone done{ task.call, task.task, 0 };
+		const int file = shm_open(task.segment, O_RDWR, 0);
+
+		if (file >= 0)
+		{
+			const size_t bytes = static_cast<size_t>(task.segmentLimbs) * sizeof(std::uint32_t);
+			void* data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+			close(file);
+
+			if (data != MAP_FAILED)
+			{
+				std::uint32_t* limbs = static_cast<std::uint32_t*>(data);
+				const std::span<const std::uint32_t> leftDigits{ limbs + task.leftOffset, static_cast<size_t>(task.leftSize) };
+				const std::span<const std::uint32_t> rightDigits{ limbs + task.rightOffset, static_cast<size_t>(task.rightSize) };
+				const std::span<std::uint32_t> out{ limbs + task.outOffset, static_cast<size_t>(task.leftSize + task.rightSize) };
+
+				done.size = BigIntegerLimbs::Multiply(leftDigits, rightDigits, out);
+
+				munmap(data, bytes);
+			}
+		}
+
+		if (!WriteAll(donePipe, &done, sizeof(done)))
+		{
+			break;
+		}
+	}
+}
+
+void BigIntegerShardPool::Stop()
+{
+	for (int* end : { &m_taskPipe[0], &m_taskPipe[1], &m_donePipe[0], &m_donePipe[1] })
+	{
+		if (*end >= 0)
+		{
+			close(*end);
+			*end = -1;
+		}
+	}
+
+	for (const int worker : m_workers)
+	{
+		while (waitpid(static_cast<pid_t>(worker), nullptr, 0) < 0 && errno == EINTR)
+		{
+
+		}
+	}
+
+	m_workers.clear();
+}
+#endif
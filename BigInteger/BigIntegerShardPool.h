@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "BigInteger.h"
+
+// Spreads single large products over worker processes on the same host. The workers are forked when
+// the pool is constructed, each one optionally pinned to a CPU and so to that CPU's NUMA node, and stay
+// until the pool is destroyed.
+//
+// A product is split by one level of Toom-3 into five independent products of a third of the size.
+// Their operands and results go through a POSIX shared memory segment, the tasks through a pipe that
+// every idle worker reads from. The coordinator then interpolates the five results into the product.
+//
+// A worker that dies is noticed while the coordinator waits, the products that did not come back are
+// then computed in the calling process and the pool goes on with the remaining workers.
+//
+// POSIX only. Elsewhere, or when the workers could not be started, Multiply computes in the calling
+// process. Construct the pool while the process has a single thread, fork copies only the caller.
+class BigIntegerShardPool
+{
+public:
+	// Toom-3 gives five products, more workers than that stay idle
+	static constexpr size_t TASK_COUNT = 5;
+	// smaller products are cheaper in process than the round trip through the workers
+	static constexpr size_t MIN_SHARD_LIMBS = 12288;
+
+private:
+	std::vector<int> m_workers;
+	// coordinator writes tasks to m_taskPipe[1], workers report to m_donePipe[1]
+	int m_taskPipe[2];
+	int m_donePipe[2];
+	std::uint64_t m_segmentCount;
+
+public:
+	// cpus lists the CPU of each worker in turn, empty leaves them unpinned. Pinning is Linux only.
+	explicit BigIntegerShardPool(size_t workerCount, std::span<const int> cpus = {});
+	~BigIntegerShardPool();
+	BigIntegerShardPool(const BigIntegerShardPool& other) = delete;
+	BigIntegerShardPool& operator=(const BigIntegerShardPool& other) = delete;
+
+public:
+	bool IsRunning() const;
+	size_t GetWorkerCount() const;
+
+	// a * b, sharded when both operands have at least MIN_SHARD_LIMBS limbs
+	BigInteger Multiply(const BigInteger& a, const BigInteger& b);
+
+private:
+	// products of the five evaluations through the workers, isReceived marks the ones that came back
+	void MultiplyRemote(std::span<const BigInteger> left, std::span<const BigInteger> right, std::span<BigInteger> products,
+		std::span<bool> isReceived);
+	// drops workers that have exited, return true when there were any
+	bool ReapWorkers();
+	static void RunWorker(int taskPipe, int donePipe);
+	void Stop();
+};
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+// Copy-on-write limb storage, used for BigInteger::m_digits when BIGINTEGER_SHARED_STORAGE is defined.
+// Copies share one reference counted buffer, const access never copies and non-const access detaches
+// a shared buffer first. An empty buffer is a null block, so moved-from storage owns nothing.
+template <typename Digits>
+class BigIntegerSharedDigits
+{
+private:
+	struct Block
+	{
+		std::atomic<size_t> references;
+		Digits digits;
+	};
+
+	Block* m_block;
+
+public:
+	using value_type = typename Digits::value_type;
+	using iterator = typename Digits::iterator;
+	using const_iterator = typename Digits::const_iterator;
+
+	BigIntegerSharedDigits()
+		: m_block{ nullptr }
+	{
+
+	}
+
+	BigIntegerSharedDigits(std::initializer_list<value_type> digits)
+		: m_block{ new Block{ 1, Digits(digits) } }
+	{
+
+	}
+
+	BigIntegerSharedDigits(const Digits& digits)
+		: m_block{ new Block{ 1, digits } }
+	{
+
+	}
+
+	BigIntegerSharedDigits(Digits&& digits)
+		: m_block{ digits.capacity() == 0 ? nullptr : new Block{ 1, std::move(digits) } }
+	{
+
+	}
+
+	BigIntegerSharedDigits(const BigIntegerSharedDigits& other) noexcept
+		: m_block{ other.m_block }
+	{
+		if (m_block != nullptr)
+		{
+			m_block->references.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	BigIntegerSharedDigits(BigIntegerSharedDigits&& other) noexcept
+		: m_block{ std::exchange(other.m_block, nullptr) }
+	{
+
+	}
+
+	BigIntegerSharedDigits& operator=(const BigIntegerSharedDigits& other) noexcept
+	{
+		BigIntegerSharedDigits copy{ other };
+
+		std::swap(m_block, copy.m_block);
+
+		return *this;
+	}
+
+	BigIntegerSharedDigits& operator=(BigIntegerSharedDigits&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+
+			m_block = std::exchange(other.m_block, nullptr);
+		}
+
+		return *this;
+	}
+
+	~BigIntegerSharedDigits()
+	{
+		Release();
+	}
+
+	const Digits& Get() const
+	{
+		static const Digits empty;
+
+		return m_block != nullptr ? m_block->digits : empty;
+	}
+
+	// the buffer owned by this object alone, copied first when it is shared
+	Digits& Mutate()
+	{
+		if (m_block == nullptr)
+		{
+			m_block = new Block{ 1, Digits() };
+		}
+		else if (m_block->references.load(std::memory_order_acquire) != 1)
+		{
+			Block* block = new Block{ 1, m_block->digits };
+
+			Release();
+
+			m_block = block;
+		}
+
+		return m_block->digits;
+	}
+
+	bool IsShared() const
+	{
+		return m_block != nullptr && m_block->references.load(std::memory_order_acquire) != 1;
+	}
+
+	operator const Digits&() const
+	{
+		return Get();
+	}
+
+	size_t size() const
+	{
+		return Get().size();
+	}
+
+	bool empty() const
+	{
+		return Get().empty();
+	}
+
+	size_t capacity() const
+	{
+		return Get().capacity();
+	}
+
+	const value_type* data() const
+	{
+		return Get().data();
+	}
+
+	value_type* data()
+	{
+		return Mutate().data();
+	}
+
+	const value_type& operator[](size_t index) const
+	{
+		return Get()[index];
+	}
+
+	value_type& operator[](size_t index)
+	{
+		return Mutate()[index];
+	}
+
+	const value_type& back() const
+	{
+		return Get().back();
+	}
+
+	const_iterator begin() const
+	{
+		return Get().begin();
+	}
+
+	const_iterator end() const
+	{
+		return Get().end();
+	}
+
+	iterator begin()
+	{
+		return Mutate().begin();
+	}
+
+	iterator end()
+	{
+		return Mutate().end();
+	}
+
+	void push_back(value_type digit)
+	{
+		Mutate().push_back(digit);
+	}
+
+	void pop_back()
+	{
+		Mutate().pop_back();
+	}
+
+	void resize(size_t size)
+	{
+		Mutate().resize(size);
+	}
+
+	void resize(size_t size, value_type digit)
+	{
+		Mutate().resize(size, digit);
+	}
+
+	void assign(size_t size, value_type digit)
+	{
+		Mutate().assign(size, digit);
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		return Mutate().erase(first, last);
+	}
+
+	void clear()
+	{
+		Mutate().clear();
+	}
+
+private:
+	void Release()
+	{
+		if (m_block != nullptr && m_block->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			delete m_block;
+		}
+
+		m_block = nullptr;
+	}
+};
@@ -0,0 +1,505 @@
+#include "BigIntegerSimd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+#include "BigIntegerSimdTarget.h"
+
+namespace
+{
+	using BigIntegerSimd::InstructionSet;
+
+	constexpr std::uint32_t BASE = 1000000000U;
+
+	// limbs handled per carry resolution step, one bit per limb in a 64-bit mask
+	constexpr std::size_t BLOCK_LIMBS = 64;
+
+	InstructionSet DetectInstructionSet()
+	{
+#if defined(BIGINTEGER_SIMD_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4]{};
+
+		__cpuid(info, 0);
+
+		if (info[0] < 7)
+		{
+			return InstructionSet::Scalar;
+		}
+
+		__cpuid(info, 1);
+
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+
+		if (!osxsave || !avx)
+		{
+			return InstructionSet::Scalar;
+		}
+
+		const unsigned long long xcr0 = _xgetbv(0);
+
+		if ((xcr0 & 0x6) != 0x6)
+		{
+			return InstructionSet::Scalar;
+		}
+
+		__cpuidex(info, 7, 0);
+
+		if ((info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6)
+		{
+			return InstructionSet::Avx512;
+		}
+
+		if ((info[1] & (1 << 5)) != 0)
+		{
+			return InstructionSet::Avx2;
+		}
+#else
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx512f"))
+		{
+			return InstructionSet::Avx512;
+		}
+
+		if (__builtin_cpu_supports("avx2"))
+		{
+			return InstructionSet::Avx2;
+		}
+#endif
+#endif
+
+		return InstructionSet::Scalar;
+	}
+
+	std::atomic<InstructionSet>& ActiveInstructionSet()
+	{
+		static std::atomic<InstructionSet> instructionSet{ DetectInstructionSet() };
+
+		return instructionSet;
+	}
+
+	// Carry lookahead over a 64 limb block. generate marks limbs that carry out on their own,
+	// propagate marks limbs that carry out only when a carry comes in. A single integer add
+	// ripples the incoming carries through runs of propagate bits.
+	std::uint64_t ResolveCarries(std::uint64_t generate, std::uint64_t propagate, std::uint32_t& carry)
+	{
+		const std::uint64_t carries = (propagate + ((generate << 1) | carry)) ^ propagate;
+
+		carry = static_cast<std::uint32_t>((generate >> 63) | ((propagate >> 63) & (carries >> 63)));
+
+		return carries;
+	}
+
+	std::uint32_t AddScalar(const std::uint32_t* a, const std::uint32_t* b, std::uint32_t* out, std::size_t count, std::uint32_t carry)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const std::uint32_t sum = a[i] + b[i] + carry;
+
+			carry = sum >= BASE ? 1 : 0;
+
+			out[i] = sum - BASE * carry;
+		}
+
+		return carry;
+	}
+
+	std::uint32_t SubtractScalar(const std::uint32_t* a, const std::uint32_t* b, std::uint32_t* out, std::size_t count, std::uint32_t borrow)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const std::uint32_t diff = a[i] - b[i] - borrow;
+
+			borrow = diff >= BASE ? 1 : 0;
+
+			out[i] = diff + BASE * borrow;
+		}
+
+		return borrow;
+	}
+
+	int CompareScalar(const std::uint32_t* a, const std::uint32_t* b, std::size_t count)
+	{
+		for (std::size_t i = count; i > 0; --i)
+		{
+			if (a[i - 1] != b[i - 1])
+			{
+				return a[i - 1] > b[i - 1] ? 1 : -1;
+			}
+		}
+
+		return 0;
+	}
+
+#if defined(BIGINTEGER_SIMD_X86)
+	BIGINTEGER_TARGET("avx2")
+	std::uint32_t AddAvx2(const std::uint32_t* a, const std::uint32_t* b, std::uint32_t* out, std::size_t count, std::uint32_t carry)
+	{
+		constexpr std::size_t LANES = 8;
+		constexpr std::size_t VECTORS = BLOCK_LIMBS / LANES;
+
+		const __m256i base = _mm256_set1_epi32(static_cast<int>(BASE));
+		const __m256i baseMinusOne = _mm256_set1_epi32(static_cast<int>(BASE - 1));
+		const __m256i laneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+
+		std::size_t i = 0;
+
+		for (; i + BLOCK_LIMBS <= count; i += BLOCK_LIMBS)
+		{
+			__m256i sums[VECTORS];
+			std::uint64_t generate = 0;
+			std::uint64_t propagate = 0;
+
+			for (std::size_t v = 0; v < VECTORS; ++v)
+			{
+				const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + v * LANES));
+				const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + v * LANES));
+
+				// limb sums stay below 2^31, so signed compares are safe
+				sums[v] = _mm256_add_epi32(x, y);
+
+				const std::uint64_t g = static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(sums[v], baseMinusOne))));
+				const std::uint64_t p = static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(sums[v], baseMinusOne))));
+
+				generate |= g << (v * LANES);
+				propagate |= p << (v * LANES);
+			}
+
+			const std::uint64_t carries = ResolveCarries(generate, propagate, carry);
+
+			for (std::size_t v = 0; v < VECTORS; ++v)
+			{
+				const __m256i bits = _mm256_set1_epi32(static_cast<int>((carries >> (v * LANES)) & 0xFF));
+				const __m256i carryMask = _mm256_cmpeq_epi32(_mm256_and_si256(bits, laneBits), laneBits);
+
+				// subtracting the all-ones mask adds the incoming carry
+				__m256i sum = _mm256_sub_epi32(sums[v], carryMask);
+				sum = _mm256_min_epu32(sum, _mm256_sub_epi32(sum, base));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + v * LANES), sum);
+			}
+		}
+
+		return AddScalar(a + i, b + i, out + i, count - i, carry);
+	}
+
+	BIGINTEGER_TARGET("avx2")
+	std::uint32_t SubtractAvx2(const std::uint32_t* a, const std::uint32_t* b, std::uint32_t* out, std::size_t count, std::uint32_t borrow)
+	{
+		constexpr std::size_t LANES = 8;
+		constexpr std::size_t VECTORS = BLOCK_LIMBS / LANES;
+
+		const __m256i base = _mm256_set1_epi32(static_cast<int>(BASE));
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i laneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+
+		std::size_t i = 0;
+
+		for (; i + BLOCK_LIMBS <= count; i += BLOCK_LIMBS)
+		{
+			__m256i diffs[VECTORS];
+			std::uint64_t generate = 0;
+			std::uint64_t propagate = 0;
+
+			for (std::size_t v = 0; v < VECTORS; ++v)
+			{
+				const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + v * LANES));
+				const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + v * LANES));
+
+				diffs[v] = _mm256_sub_epi32(x, y);
+
+				const std::uint64_t g = static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(zero, diffs[v]))));
+				const std::uint64_t p = static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(diffs[v], zero))));
+
+				generate |= g << (v * LANES);
+				propagate |= p << (v * LANES);
+			}
+
+			const std::uint64_t borrows = ResolveCarries(generate, propagate, borrow);
+
+			for (std::size_t v = 0; v < VECTORS; ++v)
+			{
+				const __m256i bits = _mm256_set1_epi32(static_cast<int>((borrows >> (v * LANES)) & 0xFF));
+				const __m256i borrowMask = _mm256_cmpeq_epi32(_mm256_and_si256(bits, laneBits), laneBits);
+
+				// negative differences wrap above BASE as unsigned, adding BASE brings them back
+				__m256i diff = _mm256_add_epi32(diffs[v], borrowMask);
+				diff = _mm256_min_epu32(diff, _mm256_add_epi32(diff, base));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + v * LANES), diff);
+			}
+		}
+
+		return SubtractScalar(a + i, b + i, out + i, count - i, borrow);
+	}
+
+	BIGINTEGER_TARGET("avx2")
+	int CompareAvx2(const std::uint32_t* a, const std::uint32_t* b, std::size_t count)
+	{
+		constexpr std::size_t LANES = 8;
+
+		std::size_t i = count;
+
+		while (i >= LANES)
+		{
+			i -= LANES;
+
+			const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+			const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+
+			const std::uint32_t different = static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, y)))) ^ 0xFFU;
+
+			if (different != 0)
+			{
+				const std::size_t top = i + 31 - std::countl_zero(different);
+
+				return a[top] > b[top] ? 1 : -1;
+			}
+		}
+
+		return CompareScalar(a, b, i);
+	}
+
+	BIGINTEGER_TARGET("avx512f")
+	std::uint32_t AddAvx512(const std::uint32_t* a, const std::uint32_t* b, std::uint32_t* out, std::size_t count, std::uint32_t carry)
+	{
+		constexpr std::size_t LANES = 16;
+		constexpr std::size_t VECTORS = BLOCK_LIMBS / LANES;
+
+		const __m512i base = _mm512_set1_epi32(static_cast<int>(BASE));
+		const __m512i baseMinusOne = _mm512_set1_epi32(static_cast<int>(BASE - 1));
+		const __m512i one = _mm512_set1_epi32(1);
+
+		std::size_t i = 0;
+
+		for (; i + BLOCK_LIMBS <= count; i += BLOCK_LIMBS)
+		{
+			__m512i sums[VECTORS];
+			std::uint64_t generate = 0;
+			std::uint64_t propagate = 0;
+
+			for (std::size_t v = 0; v < VECTORS; ++v)
+			{
+				const __m512i x = _mm512_loadu_si512(a + i + v * LANES);
+				const __m512i y = _mm512_loadu_si512(b + i + v * LANES);
+
+				sums[v] = _mm512_add_epi32(x, y);
+
+				generate |= static_cast<std::uint64_t>(_mm512_cmpgt_epu32_mask(sums[v], baseMinusOne)) << (v * LANES);
+				propagate |= static_cast<std::uint64_t>(_mm512_cmpeq_epu32_mask(sums[v], baseMinusOne)) << (v * LANES);
+			}
+
+			const std::uint64_t carries = ResolveCarries(generate, propagate, carry);
+
+			for (std::size_t v = 0; v < VECTORS; ++v)
+			{
+				const __mmask16 carryMask = static_cast<__mmask16>(carries >> (v * LANES));
+
+				__m512i sum = _mm512_mask_add_epi32(sums[v], carryMask, sums[v], one);
+				sum = _mm512_mask_sub_epi32(sum, _mm512_cmpge_epu32_mask(sum, base), sum, base);
+
+				_mm512_storeu_si512(out + i + v * LANES, sum);
+			}
+		}
+
+		return AddScalar(a + i, b + i, out + i, count - i, carry);
+	}
+
+	BIGINTEGER_TARGET("avx512f")
+	std::uint32_t SubtractAvx512(const std::uint32_t* a, const std::uint32_t* b, std::uint32_t* out, std::size_t count, std::uint32_t borrow)
+	{
+		constexpr std::size_t LANES = 16;
+		constexpr std::size_t VECTORS = BLOCK_LIMBS / LANES;
+
+		const __m512i base = _mm512_set1_epi32(static_cast<int>(BASE));
+		const __m512i zero = _mm512_setzero_si512();
+		const __m512i one = _mm512_set1_epi32(1);
+
+		std::size_t i = 0;
+
+		for (; i + BLOCK_LIMBS <= count; i += BLOCK_LIMBS)
+		{
+			__m512i diffs[VECTORS];
+			std::uint64_t generate = 0;
+			std::uint64_t propagate = 0;
+
+			for (std::size_t v = 0; v < VECTORS; ++v)
+			{
+				const __m512i x = _mm512_loadu_si512(a + i + v * LANES);
+				const __m512i y = _mm512_loadu_si512(b + i + v * LANES);
+
+				diffs[v] = _mm512_sub_epi32(x, y);
+
+				generate |= static_cast<std::uint64_t>(_mm512_cmplt_epu32_mask(x, y)) << (v * LANES);
+				propagate |= static_cast<std::uint64_t>(_mm512_cmpeq_epu32_mask(diffs[v], zero)) << (v * LANES);
+			}
+
+			const std::uint64_t borrows = ResolveCarries(generate, propagate, borrow);
+
+			for (std::size_t v = 0; v < VECTORS; ++v)
+			{
+				const __mmask16 borrowMask = static_cast<__mmask16>(borrows >> (v * LANES));
+
+				__m512i diff = _mm512_mask_sub_epi32(diffs[v], borrowMask, diffs[v], one);
+				diff = _mm512_mask_add_epi32(diff, _mm512_cmpge_epu32_mask(diff, base), diff, base);
+
+				_mm512_storeu_si512(out + i + v * LANES, diff);
+			}
+		}
+
+		return SubtractScalar(a + i, b + i, out + i, count - i, borrow);
+	}
+
+	BIGINTEGER_TARGET("avx512f")
+	int CompareAvx512(const std::uint32_t* a, const std::uint32_t* b, std::size_t count)
+	{
+		constexpr std::size_t LANES = 16;
+
+		std::size_t i = count;
+
+		while (i >= LANES)
+		{
+			i -= LANES;
+
+			const __m512i x = _mm512_loadu_si512(a + i);
+			const __m512i y = _mm512_loadu_si512(b + i);
+
+			const std::uint32_t different = _mm512_cmpneq_epu32_mask(x, y);
+
+			if (different != 0)
+			{
+				const std::size_t top = i + 31 - std::countl_zero(different);
+
+				return a[top] > b[top] ? 1 : -1;
+			}
+		}
+
+		return CompareScalar(a, b, i);
+	}
+#endif
+}
+
+namespace BigIntegerSimd
+{
+	InstructionSet GetSupportedInstructionSet()
+	{
+		static const InstructionSet supported = DetectInstructionSet();
+
+		return supported;
+	}
+
+	InstructionSet GetInstructionSet()
+	{
+		return ActiveInstructionSet().load(std::memory_order_relaxed);
+	}
+
+	void SetInstructionSet(InstructionSet instructionSet)
+	{
+		ActiveInstructionSet().store(std::min(instructionSet, GetSupportedInstructionSet()), std::memory_order_relaxed);
+	}
+
+	std::uint32_t AddLimbs(const std::uint32_t* a, const std::uint32_t* b, std::uint32_t* out, std::size_t count, std::uint32_t carry)
+	{
+#if defined(BIGINTEGER_SIMD_X86)
+		if (count >= BLOCK_LIMBS)
+		{
+			switch (GetInstructionSet())
+			{
+			case InstructionSet::Avx512:
+				return AddAvx512(a, b, out, count, carry);
+			case InstructionSet::Avx2:
+				return AddAvx2(a, b, out, count, carry);
+			default:
+				break;
+			}
+		}
+#endif
+
+		return AddScalar(a, b, out, count, carry);
+	}
+
+	std::uint32_t SubtractLimbs(const std::uint32_t* a, const std::uint32_t* b, std::uint32_t* out, std::size_t count, std::uint32_t borrow)
+	{
+#if defined(BIGINTEGER_SIMD_X86)
+		if (count >= BLOCK_LIMBS)
+		{
+			switch (GetInstructionSet())
+			{
+			case InstructionSet::Avx512:
+				return SubtractAvx512(a, b, out, count, borrow);
+			case InstructionSet::Avx2:
+				return SubtractAvx2(a, b, out, count, borrow);
+			default:
+				break;
+			}
+		}
+#endif
+
+		return SubtractScalar(a, b, out, count, borrow);
+	}
+
+	int CompareLimbs(const std::uint32_t* a, const std::uint32_t* b, std::size_t count)
+	{
+#if defined(BIGINTEGER_SIMD_X86)
+		if (count >= 16)
+		{
+			switch (GetInstructionSet())
+			{
+			case InstructionSet::Avx512:
+				return CompareAvx512(a, b, count);
+			case InstructionSet::Avx2:
+				return CompareAvx2(a, b, count);
+			default:
+				break;
+			}
+		}
+#endif
+
+		return CompareScalar(a, b, count);
+	}
+
+	std::uint32_t AddCarryLimbs(const std::uint32_t* a, std::uint32_t* out, std::size_t count, std::uint32_t carry)
+	{
+		std::size_t i = 0;
+
+		for (; i < count && carry != 0; ++i)
+		{
+			const std::uint32_t sum = a[i] + carry;
+
+			carry = sum >= BASE ? 1 : 0;
+
+			out[i] = sum - BASE * carry;
+		}
+
+		if (out != a)
+		{
+			std::copy(a + i, a + count, out + i);
+		}
+
+		return carry;
+	}
+
+	std::uint32_t SubtractBorrowLimbs(const std::uint32_t* a, std::uint32_t* out, std::size_t count, std::uint32_t borrow)
+	{
+		std::size_t i = 0;
+
+		for (; i < count && borrow != 0; ++i)
+		{
+			const std::uint32_t diff = a[i] - borrow;
+
+			borrow = diff >= BASE ? 1 : 0;
+
+			out[i] = diff + BASE * borrow;
+		}
+
+		if (out != a)
+		{
+			std::copy(a + i, a + count, out + i);
+		}
+
+		return borrow;
+	}
+}
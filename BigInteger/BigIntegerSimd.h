@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized base 10^9 limb kernels, selected at runtime by CPU feature detection.
+namespace BigIntegerSimd
+{
+	enum class InstructionSet
+	{
+		Scalar,
+		Avx2,
+		Avx512
+	};
+
+	InstructionSet GetSupportedInstructionSet();
+	InstructionSet GetInstructionSet();
+
+	// clamps to the supported instruction set, mainly for benchmarking the fallbacks
+	void SetInstructionSet(InstructionSet instructionSet);
+
+	// out[0, count) = a + b + carry, returns the carry out of the top limb. out may alias a or b.
+	std::uint32_t AddLimbs(const std::uint32_t* a, const std::uint32_t* b, std::uint32_t* out, std::size_t count, std::uint32_t carry);
+
+	// out[0, count) = a - b - borrow, returns the borrow out of the top limb. out may alias a or b.
+	std::uint32_t SubtractLimbs(const std::uint32_t* a, const std::uint32_t* b, std::uint32_t* out, std::size_t count, std::uint32_t borrow);
+
+	// scans from the top limb down, return 1 when a > b, return 0 when a == b, return -1 when a < b
+	int CompareLimbs(const std::uint32_t* a, const std::uint32_t* b, std::size_t count);
+
+	// out[0, count) = a + carry, returns the carry out of the top limb
+	std::uint32_t AddCarryLimbs(const std::uint32_t* a, std::uint32_t* out, std::size_t count, std::uint32_t carry);
+
+	// out[0, count) = a - borrow, returns the borrow out of the top limb
+	std::uint32_t SubtractBorrowLimbs(const std::uint32_t* a, std::uint32_t* out, std::size_t count, std::uint32_t borrow);
+}
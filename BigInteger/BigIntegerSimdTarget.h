@@ -0,0 +1,18 @@
+#pragma once
+
+// Per-function instruction set targets, so AVX2 and AVX-512 kernels build without global compiler flags.
+// Include only from translation units, the macros are not part of the public headers.
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BIGINTEGER_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define BIGINTEGER_TARGET(features)
+#else
+#define BIGINTEGER_TARGET(features) __attribute__((target(features)))
+#endif
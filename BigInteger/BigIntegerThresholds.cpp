@@ -0,0 +1,175 @@
+#include "BigIntegerThresholds.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+	struct Entry
+	{
+		const char* name;
+		size_t BigIntegerThresholds::* member;
+		// smaller values would make the algorithm recurse forever or start empty threads
+		size_t minimum;
+	};
+
+	constexpr Entry ENTRIES[]{
+		{ "karatsuba_limbs", &BigIntegerThresholds::karatsubaLimbs, 4 },
+		{ "ntt_limbs", &BigIntegerThresholds::nttLimbs, 1 },
+		{ "radix_basecase_limbs", &BigIntegerThresholds::radixBasecaseLimbs, 1 },
+		{ "parallel_text_limbs", &BigIntegerThresholds::parallelTextLimbs, 1 }
+	};
+
+	constexpr size_t ENTRY_COUNT = sizeof(ENTRIES) / sizeof(ENTRIES[0]);
+
+	// read on every multiplication, so each value is a relaxed atomic rather than a locked struct
+	struct ActiveThresholds
+	{
+		std::atomic<size_t> values[ENTRY_COUNT];
+
+		explicit ActiveThresholds(const BigIntegerThresholds& thresholds)
+		{
+			for (size_t i = 0; i < ENTRY_COUNT; ++i)
+			{
+				values[i].store(thresholds.*ENTRIES[i].member, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	BigIntegerThresholds Clamp(BigIntegerThresholds thresholds)
+	{
+		for (const Entry& entry : ENTRIES)
+		{
+			thresholds.*entry.member = std::max(thresholds.*entry.member, entry.minimum);
+		}
+
+		return thresholds;
+	}
+
+	BigIntegerThresholds LoadInitialThresholds()
+	{
+		BigIntegerThresholds thresholds;
+		std::string path;
+
+#if defined(_MSC_VER)
+		char* value = nullptr;
+		size_t length = 0;
+
+		if (_dupenv_s(&value, &length, "BIGINTEGER_THRESHOLDS") == 0 && value != nullptr)
+		{
+			path = value;
+			std::free(value);
+		}
+#else
+		if (const char* value = std::getenv("BIGINTEGER_THRESHOLDS"))
+		{
+			path = value;
+		}
+#endif
+
+		if (!path.empty())
+		{
+			BigIntegerTuning::LoadThresholds(path, thresholds);
+		}
+
+		return Clamp(thresholds);
+	}
+
+	ActiveThresholds& GetActiveThresholds()
+	{
+		static ActiveThresholds active{ LoadInitialThresholds() };
+
+		return active;
+	}
+}
+
+namespace BigIntegerTuning
+{
+	BigIntegerThresholds GetThresholds()
+	{
+		const ActiveThresholds& active = GetActiveThresholds();
+		BigIntegerThresholds thresholds;
+
+		for (size_t i = 0; i < ENTRY_COUNT; ++i)
+		{
+			thresholds.*ENTRIES[i].member = active.values[i].load(std::memory_order_relaxed);
+		}
+
+		return thresholds;
+	}
+
+	void SetThresholds(const BigIntegerThresholds& thresholds)
+	{
+		ActiveThresholds& active = GetActiveThresholds();
+		const BigIntegerThresholds clamped = Clamp(thresholds);
+
+		for (size_t i = 0; i < ENTRY_COUNT; ++i)
+		{
+			active.values[i].store(clamped.*ENTRIES[i].member, std::memory_order_relaxed);
+		}
+	}
+
+	bool LoadThresholds(const std::string& path, BigIntegerThresholds& thresholds)
+	{
+		std::ifstream file{ path };
+
+		if (!file)
+		{
+			return false;
+		}
+
+		BigIntegerThresholds loaded = thresholds;
+		std::string line;
+
+		while (std::getline(file, line))
+		{
+			line = line.substr(0, line.find('#'));
+
+			std::istringstream iss{ line };
+			std::string name;
+			size_t value = 0;
+
+			if (!(iss >> name))
+			{
+				continue;
+			}
+
+			const Entry* entry = std::find_if(std::begin(ENTRIES), std::end(ENTRIES), [&name](const Entry& e) { return name == e.name; });
+
+			if (entry == std::end(ENTRIES) || !(iss >> value))
+			{
+				return false;
+			}
+
+			loaded.*entry->member = value;
+		}
+
+		thresholds = loaded;
+
+		return true;
+	}
+
+	bool SaveThresholds(const std::string& path, const BigIntegerThresholds& thresholds)
+	{
+		std::ofstream file{ path };
+
+		file << ToText(thresholds);
+
+		return file.good();
+	}
+
+	std::string ToText(const BigIntegerThresholds& thresholds)
+	{
+		std::ostringstream oss;
+
+		for (const Entry& entry : ENTRIES)
+		{
+			oss << entry.name << ' ' << thresholds.*entry.member << '\n';
+		}
+
+		return oss.str();
+	}
+}
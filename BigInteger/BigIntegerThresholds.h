@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Crossover points between algorithms, in limbs. The defaults suit a generic x86-64 host;
+// BigIntegerTune measures them on the current machine and writes a file for Load().
+struct BigIntegerThresholds
+{
+	// size of the shorter multiplication operand from which Karatsuba replaces schoolbook
+	size_t karatsubaLimbs = 40;
+	// size of the shorter multiplication operand from which the NTT replaces Karatsuba
+	size_t nttLimbs = 16384;
+	// size below which radix conversion runs one Horner pass instead of splitting
+	size_t radixBasecaseLimbs = 64;
+	// limbs each thread has to get before parallel parsing and formatting start a thread
+	size_t parallelTextLimbs = 16384;
+};
+
+// The active thresholds are process-wide. On first use they are loaded from the file named by the
+// BIGINTEGER_THRESHOLDS environment variable when it is set.
+namespace BigIntegerTuning
+{
+	BigIntegerThresholds GetThresholds();
+	void SetThresholds(const BigIntegerThresholds& thresholds);
+
+	// "name value" lines, '#' starts a comment and missing names keep their default
+	// return false when the file cannot be read or has an unknown name or a bad value
+	bool LoadThresholds(const std::string& path, BigIntegerThresholds& thresholds);
+	bool SaveThresholds(const std::string& path, const BigIntegerThresholds& thresholds);
+	std::string ToText(const BigIntegerThresholds& thresholds);
+}
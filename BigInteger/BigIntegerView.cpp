@@ -0,0 +1,129 @@
+#include "BigIntegerView.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <sstream>
+
+#include "BigIntegerLimbs.h"
+#include "BigIntegerParallel.h"
+#include "BigIntegerProfiler.h"
+#include "BigIntegerThresholds.h"
+
+namespace
+{
+	constexpr std::uint32_t ZERO_DIGITS[1]{ 0 };
+}
+
+BigIntegerView::BigIntegerView()
+	: m_digits{ ZERO_DIGITS }, m_isNegative{ false }
+{
+
+}
+
+BigIntegerView::BigIntegerView(std::span<const std::uint32_t> digits, bool isNegative)
+	: m_digits{ digits }, m_isNegative{ isNegative }
+{
+	assert(!digits.empty() && (digits.size() == 1 || digits.back() != 0));
+}
+
+std::span<const std::uint32_t> BigIntegerView::GetDigits() const
+{
+	return m_digits;
+}
+
+bool BigIntegerView::IsNegative() const
+{
+	return m_isNegative;
+}
+
+bool BigIntegerView::IsZero() const
+{
+	return m_digits.size() == 1 && m_digits[0] == 0;
+}
+
+std::strong_ordering BigIntegerView::operator<=>(const BigIntegerView& other) const
+{
+	if (m_isNegative != other.m_isNegative)
+	{
+		return m_isNegative ? std::strong_ordering::less : std::strong_ordering::greater;
+	}
+
+	const int magnitude = BigIntegerLimbs::CompareMagnitude(m_digits, other.m_digits);
+
+	return (m_isNegative ? -magnitude : magnitude) <=> 0;
+}
+
+bool BigIntegerView::operator==(const BigIntegerView& other) const
+{
+	return (*this <=> other) == 0;
+}
+
+std::string BigIntegerView::ToString() const
+{
+	BIGINTEGER_PROFILE_KERNEL(Format, m_digits.size());
+
+	std::ostringstream oss;
+
+	if (m_isNegative)
+	{
+		oss << '-';
+	}
+
+	const size_t size = m_digits.size();
+
+	// every limb below the top one is written as exactly 9 digits
+	oss << m_digits[size - 1] << std::setfill('0');
+
+	for (size_t i = size - 1; i > 0; --i)
+	{
+		oss << std::setw(9) << m_digits[i - 1];
+	}
+
+	return oss.str();
+}
+
+std::string BigIntegerView::ToStringParallel(size_t threadCount) const
+{
+	const size_t size = m_digits.size();
+
+	threadCount = BigIntegerParallel::GetThreadCount(threadCount, size - 1, BigIntegerTuning::GetThresholds().parallelTextLimbs);
+
+	if (threadCount == 1)
+	{
+		return ToString();
+	}
+
+	BIGINTEGER_PROFILE_KERNEL(Format, size);
+
+	// only the top limb has a variable width, it is written before the threads start
+	const std::string top = std::to_string(m_digits[size - 1]);
+	const size_t prefix = (m_isNegative ? 1 : 0) + top.size();
+
+	std::string text(prefix + (size - 1) * 9, '0');
+
+	if (m_isNegative)
+	{
+		text[0] = '-';
+	}
+
+	std::copy(top.begin(), top.end(), text.begin() + (m_isNegative ? 1 : 0));
+
+	BigIntegerParallel::ForEachChunk(size - 1, threadCount, [this, &text](size_t, size_t begin, size_t end)
+	{
+		for (size_t limb = begin; limb < end; ++limb)
+		{
+			// limb i ends 9 * i characters from the end
+			char* out = text.data() + text.size() - (limb + 1) * 9;
+			std::uint32_t digit = m_digits[limb];
+
+			for (size_t i = 9; i > 0; --i)
+			{
+				out[i - 1] = static_cast<char>('0' + digit % 10);
+				digit /= 10;
+			}
+		}
+	});
+
+	return text;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+// Read-only signed value over limbs owned elsewhere, a BigInteger, a caller buffer or a mapped file.
+// The limbs follow the BigInteger layout: base 10^9, least significant first, no leading zero limbs.
+class BigIntegerView
+{
+private:
+	std::span<const std::uint32_t> m_digits;
+	bool m_isNegative;
+
+public:
+	// views zero
+	BigIntegerView();
+	BigIntegerView(std::span<const std::uint32_t> digits, bool isNegative);
+
+	std::span<const std::uint32_t> GetDigits() const;
+	bool IsNegative() const;
+	bool IsZero() const;
+
+	std::strong_ordering operator<=>(const BigIntegerView& other) const;
+	bool operator==(const BigIntegerView& other) const;
+
+	std::string ToString() const;
+	// each thread writes its limbs straight into the pre-sized result, threadCount 0 means one per core
+	std::string ToStringParallel(size_t threadCount = 0) const;
+};
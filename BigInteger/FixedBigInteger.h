@@ -0,0 +1,460 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "BigInteger.h"
+#include "BigIntegerView.h"
+
+// Signed integer of at most Limbs base 10^9 limbs kept inline, for values with a known bound
+// (a 256-bit value needs 9 limbs, 512-bit 18 and 1024-bit 35).
+// Unused high limbs are always 0 and zero is never negative, so copies are plain memcpy and
+// every loop runs over the full width with no size branches.
+// The operators assert on overflow, the Checked* functions report it instead.
+template<size_t Limbs>
+class FixedBigInteger
+{
+	static_assert(Limbs > 0);
+
+public:
+	static constexpr std::uint64_t BASE = 1000000000ULL;
+	static constexpr size_t LIMBS = Limbs;
+
+private:
+	std::array<std::uint32_t, Limbs> m_digits{};
+	bool m_isNegative = false;
+
+public:
+	constexpr FixedBigInteger() = default;
+	constexpr FixedBigInteger(std::int32_t number) : FixedBigInteger(static_cast<std::int64_t>(number)) {}
+	constexpr FixedBigInteger(std::uint32_t number) : FixedBigInteger(static_cast<std::uint64_t>(number)) {}
+	constexpr FixedBigInteger(std::int64_t number)
+		: FixedBigInteger(number < 0 ? 0 - static_cast<std::uint64_t>(number) : static_cast<std::uint64_t>(number))
+	{
+		m_isNegative = number < 0;
+	}
+	constexpr FixedBigInteger(std::uint64_t number)
+	{
+		for (size_t i = 0; i < Limbs && number > 0; ++i)
+		{
+			m_digits[i] = static_cast<std::uint32_t>(number % BASE);
+			number /= BASE;
+		}
+
+		// a single limb cannot hold every uint64
+		assert(number == 0);
+	}
+
+	// widening is exact, so literals of any width mix with wider values on either side of an operator
+	template<size_t OtherLimbs> requires (OtherLimbs < Limbs)
+	constexpr FixedBigInteger(const FixedBigInteger<OtherLimbs>& other)
+		: m_isNegative{ other.IsNegative() }
+	{
+		for (size_t i = 0; i < OtherLimbs; ++i)
+		{
+			m_digits[i] = other.GetDigits()[i];
+		}
+	}
+
+	// the value has to fit, see Assign() for a checked conversion
+	explicit FixedBigInteger(const BigIntegerView& view)
+	{
+		const bool isAssigned = Assign(view);
+
+		assert(isAssigned);
+		(void)isAssigned;
+	}
+
+	explicit FixedBigInteger(const BigInteger& number)
+		: FixedBigInteger(number.GetView())
+	{
+
+	}
+
+public:
+	// hidden friends, so a narrower left operand widens as a right one does and the result is the wider type
+	friend constexpr FixedBigInteger operator+(const FixedBigInteger& a, const FixedBigInteger& b)
+	{
+		FixedBigInteger result;
+
+		const bool isOverflow = !CheckedAdd(a, b, result);
+
+		assert(!isOverflow);
+		(void)isOverflow;
+
+		return result;
+	}
+
+	friend constexpr FixedBigInteger operator-(const FixedBigInteger& a, const FixedBigInteger& b)
+	{
+		FixedBigInteger result;
+
+		const bool isOverflow = !CheckedSubtract(a, b, result);
+
+		assert(!isOverflow);
+		(void)isOverflow;
+
+		return result;
+	}
+
+	friend constexpr FixedBigInteger operator*(const FixedBigInteger& a, const FixedBigInteger& b)
+	{
+		FixedBigInteger result;
+
+		const bool isOverflow = !CheckedMultiply(a, b, result);
+
+		assert(!isOverflow);
+		(void)isOverflow;
+
+		return result;
+	}
+
+	constexpr FixedBigInteger operator-() const
+	{
+		FixedBigInteger result = *this;
+
+		result.m_isNegative = !m_isNegative && !IsZero();
+
+		return result;
+	}
+
+	constexpr FixedBigInteger& operator+=(const FixedBigInteger& other)
+	{
+		return *this = *this + other;
+	}
+
+	constexpr FixedBigInteger& operator-=(const FixedBigInteger& other)
+	{
+		return *this = *this - other;
+	}
+
+	constexpr FixedBigInteger& operator*=(const FixedBigInteger& other)
+	{
+		return *this = *this * other;
+	}
+
+	friend constexpr std::strong_ordering operator<=>(const FixedBigInteger& a, const FixedBigInteger& b)
+	{
+		if (a.m_isNegative != b.m_isNegative)
+		{
+			return a.m_isNegative ? std::strong_ordering::less : std::strong_ordering::greater;
+		}
+
+		const int magnitude = CompareMagnitude(a.m_digits, b.m_digits);
+
+		return (a.m_isNegative ? -magnitude : magnitude) <=> 0;
+	}
+
+	friend constexpr bool operator==(const FixedBigInteger& a, const FixedBigInteger& b) = default;
+
+public:
+	// return false when the result does not fit, result then holds the low Limbs limbs of the magnitude
+	static constexpr bool CheckedAdd(const FixedBigInteger& a, const FixedBigInteger& b, FixedBigInteger& result)
+	{
+		return AddSigned(a, b.m_digits, b.m_isNegative, result);
+	}
+
+	static constexpr bool CheckedSubtract(const FixedBigInteger& a, const FixedBigInteger& b, FixedBigInteger& result)
+	{
+		return AddSigned(a, b.m_digits, !b.m_isNegative, result);
+	}
+
+	static constexpr bool CheckedMultiply(const FixedBigInteger& a, const FixedBigInteger& b, FixedBigInteger& result)
+	{
+		std::array<std::uint32_t, Limbs> digits{};
+		bool isOverflow = false;
+
+		for (size_t i = 0; i < Limbs; ++i)
+		{
+			const std::uint64_t digit = a.m_digits[i];
+
+			if (digit == 0)
+			{
+				continue;
+			}
+
+			std::uint64_t carry = 0;
+
+			for (size_t j = 0; i + j < Limbs; ++j)
+			{
+				const std::uint64_t product = digit * b.m_digits[j] + digits[i + j] + carry;
+
+				carry = product / BASE;
+
+				digits[i + j] = static_cast<std::uint32_t>(product % BASE);
+			}
+
+			// the limbs of b that would land past the top
+			for (size_t j = Limbs - i; j < Limbs; ++j)
+			{
+				isOverflow = isOverflow || b.m_digits[j] != 0;
+			}
+
+			isOverflow = isOverflow || carry != 0;
+		}
+
+		result.m_digits = digits;
+		result.m_isNegative = a.m_isNegative != b.m_isNegative && !result.IsZero();
+
+		return !isOverflow;
+	}
+
+public:
+	constexpr bool IsNegative() const
+	{
+		return m_isNegative;
+	}
+
+	constexpr bool IsZero() const
+	{
+		for (size_t i = 0; i < Limbs; ++i)
+		{
+			if (m_digits[i] != 0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	constexpr const std::array<std::uint32_t, Limbs>& GetDigits() const
+	{
+		return m_digits;
+	}
+
+	// decimal text with an optional '-' as BigInteger(const std::string&) takes it,
+	// return false and leave result unchanged when it is malformed or needs more than Limbs limbs
+	static constexpr bool Parse(std::string_view number, FixedBigInteger& result)
+	{
+		const bool isNegative = !number.empty() && number[0] == '-';
+		size_t position = isNegative ? 1 : 0;
+
+		if (position == number.size())
+		{
+			return false;
+		}
+
+		for (size_t i = position; i < number.size(); ++i)
+		{
+			if (number[i] < '0' || number[i] > '9')
+			{
+				return false;
+			}
+		}
+
+		// leading zeros do not count against the width
+		while (position + 1 < number.size() && number[position] == '0')
+		{
+			++position;
+		}
+
+		if ((number.size() - position + 8) / 9 > Limbs)
+		{
+			return false;
+		}
+
+		FixedBigInteger parsed;
+		size_t end = number.size();
+
+		// one limb per 9 characters from the right
+		for (size_t limb = 0; end > position; ++limb)
+		{
+			const size_t begin = end - position > 9 ? end - 9 : position;
+			std::uint32_t digit = 0;
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				digit = digit * 10 + static_cast<std::uint32_t>(number[i] - '0');
+			}
+
+			parsed.m_digits[limb] = digit;
+			end = begin;
+		}
+
+		parsed.m_isNegative = isNegative && !parsed.IsZero();
+		result = parsed;
+
+		return true;
+	}
+
+	// return false and leave this unchanged when view needs more than Limbs limbs
+	bool Assign(const BigIntegerView& view)
+	{
+		const std::span<const std::uint32_t> digits = view.GetDigits();
+
+		if (digits.size() > Limbs)
+		{
+			return false;
+		}
+
+		m_digits = {};
+
+		for (size_t i = 0; i < digits.size(); ++i)
+		{
+			m_digits[i] = digits[i];
+		}
+
+		m_isNegative = view.IsNegative();
+
+		return true;
+	}
+
+	// views the limbs in place, valid while this lives
+	BigIntegerView GetView() const
+	{
+		size_t size = Limbs;
+
+		while (size > 1 && m_digits[size - 1] == 0)
+		{
+			--size;
+		}
+
+		return BigIntegerView{ std::span<const std::uint32_t>(m_digits.data(), size), m_isNegative };
+	}
+
+	BigInteger ToBigInteger() const
+	{
+		return BigInteger{ GetView() };
+	}
+
+	std::string ToString() const
+	{
+		return GetView().ToString();
+	}
+
+private:
+	// return 1 when a > b, return 0 when a == b, return -1 when a < b
+	static constexpr int CompareMagnitude(const std::array<std::uint32_t, Limbs>& a, const std::array<std::uint32_t, Limbs>& b)
+	{
+		for (size_t i = Limbs; i > 0; --i)
+		{
+			if (a[i - 1] != b[i - 1])
+			{
+				return a[i - 1] > b[i - 1] ? 1 : -1;
+			}
+		}
+
+		return 0;
+	}
+
+	static constexpr bool AddSigned(const FixedBigInteger& a, const std::array<std::uint32_t, Limbs>& b, bool isNegative, FixedBigInteger& result)
+	{
+		std::array<std::uint32_t, Limbs> digits{};
+
+		if (a.m_isNegative == isNegative)
+		{
+			std::uint64_t carry = 0;
+
+			for (size_t i = 0; i < Limbs; ++i)
+			{
+				const std::uint64_t sum = static_cast<std::uint64_t>(a.m_digits[i]) + b[i] + carry;
+
+				carry = sum >= BASE ? 1 : 0;
+
+				digits[i] = static_cast<std::uint32_t>(sum - carry * BASE);
+			}
+
+			result.m_digits = digits;
+			result.m_isNegative = isNegative && !result.IsZero();
+
+			return carry == 0;
+		}
+
+		// different signs, the smaller magnitude is taken from the larger one
+		const int diff = CompareMagnitude(a.m_digits, b);
+		const std::array<std::uint32_t, Limbs>& larger = diff >= 0 ? a.m_digits : b;
+		const std::array<std::uint32_t, Limbs>& smaller = diff >= 0 ? b : a.m_digits;
+
+		std::uint32_t borrow = 0;
+
+		for (size_t i = 0; i < Limbs; ++i)
+		{
+			const std::uint64_t subtrahend = static_cast<std::uint64_t>(smaller[i]) + borrow;
+
+			borrow = larger[i] < subtrahend ? 1 : 0;
+
+			digits[i] = static_cast<std::uint32_t>(larger[i] + borrow * BASE - subtrahend);
+		}
+
+		result.m_digits = digits;
+		result.m_isNegative = diff != 0 && (diff > 0 ? a.m_isNegative : isNegative);
+
+		return true;
+	}
+};
+
+static_assert(std::is_trivially_copyable_v<FixedBigInteger<1>>);
+
+// Decimal literal parsed at compile time into a FixedBigInteger just wide enough for its digits:
+//   using namespace BigIntegerLiterals;
+//   constexpr auto MODULUS = 1000000007_bi;
+// Digit separators are allowed. Hex, octal, binary and floating point literals fail to compile,
+// and so does a leading 0, which C++ would read as octal.
+namespace BigIntegerLiterals
+{
+	template<char... Chars>
+	consteval auto operator""_bi()
+	{
+		constexpr char TEXT[]{ Chars... };
+		constexpr size_t LENGTH = sizeof...(Chars);
+
+		constexpr size_t DIGIT_COUNT = []()
+		{
+			size_t count = 0;
+
+			for (size_t i = 0; i < LENGTH; ++i)
+			{
+				count += TEXT[i] != '\'' ? 1 : 0;
+			}
+
+			return count;
+		}();
+
+		constexpr bool IS_DECIMAL = []()
+		{
+			for (size_t i = 0; i < LENGTH; ++i)
+			{
+				if ((TEXT[i] < '0' || TEXT[i] > '9') && TEXT[i] != '\'')
+				{
+					return false;
+				}
+			}
+
+			return TEXT[0] != '0' || LENGTH == 1;
+		}();
+
+		static_assert(IS_DECIMAL, "_bi takes a decimal integer literal without a leading 0");
+
+		std::array<char, LENGTH> digits{};
+		size_t size = 0;
+
+		for (size_t i = 0; i < LENGTH; ++i)
+		{
+			if (TEXT[i] != '\'')
+			{
+				digits[size++] = TEXT[i];
+			}
+		}
+
+		FixedBigInteger<(DIGIT_COUNT + 8) / 9> result;
+
+		FixedBigInteger<(DIGIT_COUNT + 8) / 9>::Parse(std::string_view(digits.data(), size), result);
+
+		return result;
+	}
+
+	// a literal widens to the wider operand on either side
+	static_assert(std::is_same_v<decltype(1_bi + FixedBigInteger<4>{ 3 }), FixedBigInteger<4>>);
+	static_assert(1_bi + FixedBigInteger<4>{ 3 } == FixedBigInteger<4>{ 4 });
+	static_assert(2_bi - FixedBigInteger<4>{ 3 } == FixedBigInteger<4>{ -1 });
+	static_assert(2_bi * FixedBigInteger<4>{ 3 } == FixedBigInteger<4>{ 6 });
+	static_assert(1_bi < FixedBigInteger<4>{ 3 } && FixedBigInteger<4>{ 3 } > 1_bi);
+}
@@ -0,0 +1,139 @@
+#include "LazyBigInteger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+LazyBigInteger::LazyBigInteger(std::string text)
+{
+	// on failure the text keeps its default, zero
+	if (!TryParse(std::move(text), *this))
+	{
+		assert(false);
+	}
+}
+
+LazyBigInteger::LazyBigInteger(const BigInteger& number)
+	: m_text{ number.ToString() }
+	, m_number{ number }
+{
+
+}
+
+bool LazyBigInteger::TryParse(std::string text, LazyBigInteger& number)
+{
+	if (!Canonicalize(text))
+	{
+		return false;
+	}
+
+	number.m_text = std::move(text);
+	number.m_number.reset();
+
+	return true;
+}
+
+const BigInteger& LazyBigInteger::GetNumber() const
+{
+	if (!m_number)
+	{
+		m_number.emplace(m_text);
+	}
+
+	return *m_number;
+}
+
+LazyBigInteger::operator const BigInteger&() const
+{
+	return GetNumber();
+}
+
+const std::string& LazyBigInteger::ToString() const
+{
+	return m_text;
+}
+
+bool LazyBigInteger::IsNegative() const
+{
+	return m_text[0] == '-';
+}
+
+bool LazyBigInteger::IsZero() const
+{
+	return m_text == "0";
+}
+
+bool LazyBigInteger::IsConverted() const
+{
+	return m_number.has_value();
+}
+
+std::strong_ordering LazyBigInteger::operator<=>(const LazyBigInteger& other) const
+{
+	if (IsNegative() != other.IsNegative())
+	{
+		return IsNegative() ? std::strong_ordering::less : std::strong_ordering::greater;
+	}
+
+	// without leading zeros the longer magnitude is the larger one, equal lengths compare as text
+	std::strong_ordering magnitude = m_text.size() <=> other.m_text.size();
+
+	if (magnitude == 0)
+	{
+		const int order = m_text.compare(other.m_text);
+
+		magnitude = order < 0 ? std::strong_ordering::less : (order > 0 ? std::strong_ordering::greater : std::strong_ordering::equal);
+	}
+
+	return IsNegative() ? 0 <=> magnitude : magnitude;
+}
+
+bool LazyBigInteger::operator==(const LazyBigInteger& other) const
+{
+	return m_text == other.m_text;
+}
+
+size_t LazyBigInteger::Hash() const
+{
+	return std::hash<std::string_view>{}(m_text);
+}
+
+bool LazyBigInteger::Canonicalize(std::string& text)
+{
+	const size_t start = !text.empty() && text[0] == '-' ? 1 : 0;
+
+	if (start == text.size())
+	{
+		return false;
+	}
+
+	for (size_t i = start; i < text.size(); ++i)
+	{
+		if (text[i] < '0' || text[i] > '9')
+		{
+			return false;
+		}
+	}
+
+	const size_t firstNonzero = std::min(text.find_first_not_of('0', start), text.size() - 1);
+
+	// the common case, already canonical, keeps the text untouched
+	if (firstNonzero == start && text != "-0")
+	{
+		return true;
+	}
+
+	text.erase(start, firstNonzero - start);
+
+	if (text == "-0")
+	{
+		text.erase(0, 1);
+	}
+
+	return true;
+}
+
+std::ostream& operator<<(std::ostream& os, const LazyBigInteger& number)
+{
+	return os << number.ToString();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "BigInteger.h"
+
+// A decimal value that stays text until arithmetic needs its limbs. Comparing, hashing and printing
+// work on the text, so values that are only passed through never pay for the conversion.
+// The text is kept canonical (no leading zeros, no "-0"), input already in that form is stored as is
+// and written back byte for byte.
+//
+// The limbs are cached on first use, so a const object must not be converted from several threads at once.
+class LazyBigInteger
+{
+private:
+	std::string m_text{ "0" };
+	mutable std::optional<BigInteger> m_number;
+
+public:
+	LazyBigInteger() = default;
+	// same grammar as BigInteger(const std::string&), invalid text asserts and becomes zero
+	explicit LazyBigInteger(std::string text);
+	explicit LazyBigInteger(const BigInteger& number);
+
+	// return false instead of asserting when the text is not a decimal integer
+	static bool TryParse(std::string text, LazyBigInteger& number);
+
+public:
+	// converts on the first call
+	const BigInteger& GetNumber() const;
+	operator const BigInteger&() const;
+
+	const std::string& ToString() const;
+	bool IsNegative() const;
+	bool IsZero() const;
+	bool IsConverted() const;
+
+	// sign, then length, then the digits, as the text is canonical
+	std::strong_ordering operator<=>(const LazyBigInteger& other) const;
+	bool operator==(const LazyBigInteger& other) const;
+
+	size_t Hash() const;
+
+private:
+	// strips leading zeros and the sign of zero in place, return false when the text is not a number
+	static bool Canonicalize(std::string& text);
+};
+
+std::ostream& operator<<(std::ostream& os, const LazyBigInteger& number);
+
+template <>
+struct std::hash<LazyBigInteger>
+{
+	size_t operator()(const LazyBigInteger& number) const noexcept
+	{
+		return number.Hash();
+	}
+};
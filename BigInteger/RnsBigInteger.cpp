@@ -0,0 +1,512 @@
+#include "RnsBigInteger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+#include "BigIntegerArithmetic.h"
+#include "BigIntegerLimbs.h"
+
+namespace
+{
+	constexpr std::uint32_t BASE = 1000000000;
+
+	// the tree is walked down to nodes of 2^LEAF_LEVEL primes, which are split with word operations
+	constexpr size_t LEAF_LEVEL = 4;
+
+	// reciprocals of divisors up to this many limbs come straight from the schoolbook division
+	constexpr size_t RECIPROCAL_BASECASE_LIMBS = 16;
+
+	size_t GetLimbCount(const BigInteger& value)
+	{
+		return value.GetView().GetDigits().size();
+	}
+
+	BigInteger GetPowerOfBase(size_t exponent)
+	{
+		BigInteger power{ 1 };
+
+		power.ShiftLimbs(static_cast<std::ptrdiff_t>(exponent));
+
+		return power;
+	}
+
+	// floor(BASE^(2s) / divisor) for a divisor of s limbs. The reciprocal of the top half plus two limbs
+	// is refined by one Newton step, which leaves it a few units off, then fixed up exactly.
+	BigInteger GetReciprocal(const BigInteger& divisor)
+	{
+		const size_t size = GetLimbCount(divisor);
+		const BigInteger power = GetPowerOfBase(2 * size);
+
+		if (size <= RECIPROCAL_BASECASE_LIMBS)
+		{
+			return power / divisor;
+		}
+
+		const size_t half = size / 2 + 2;
+		BigInteger top = divisor;
+
+		top.ShiftLimbs(-static_cast<std::ptrdiff_t>(size - half));
+
+		BigInteger reciprocal = GetReciprocal(top);
+
+		reciprocal.ShiftLimbs(static_cast<std::ptrdiff_t>(size - half));
+
+		BigInteger correction = reciprocal * (power - divisor * reciprocal);
+
+		correction.ShiftLimbs(-static_cast<std::ptrdiff_t>(2 * size));
+		reciprocal += correction;
+
+		BigInteger remainder = power - divisor * reciprocal;
+
+		while (remainder < 0)
+		{
+			reciprocal -= 1;
+			remainder += divisor;
+		}
+
+		while (remainder >= divisor)
+		{
+			reciprocal += 1;
+			remainder -= divisor;
+		}
+
+		return reciprocal;
+	}
+
+	// limbs [0, count) of value
+	BigInteger GetLowLimbs(const BigInteger& value, size_t count)
+	{
+		const std::span<const std::uint32_t> digits = value.GetView().GetDigits().first(count);
+
+		return BigInteger{ BigIntegerView{ digits.first(BigIntegerLimbs::GetNormalizedSize(digits)), false } };
+	}
+
+	// the largest primes below BASE, largest first, until their product has more than digits decimal digits,
+	// by a sieve over a window under BASE. Fewer when all odd primes below BASE do not reach it.
+	std::vector<std::uint32_t> FindPrimes(double digits)
+	{
+		// the window reaches down to 3
+		constexpr std::uint32_t MAX_WINDOW = BASE - 3;
+
+		// odd divisors up to sqrt(BASE) are enough to sieve the window
+		constexpr std::uint32_t SQRT_BASE = 31623;
+
+		std::vector<bool> isComposite(SQRT_BASE + 1, false);
+		std::vector<std::uint32_t> divisors;
+
+		for (std::uint32_t i = 3; i <= SQRT_BASE; i += 2)
+		{
+			if (isComposite[i])
+			{
+				continue;
+			}
+
+			divisors.push_back(i);
+
+			for (std::uint32_t j = i * i; j <= SQRT_BASE; j += 2 * i)
+			{
+				isComposite[j] = true;
+			}
+		}
+
+		// primes near 10^9 are about 21 apart and add 9 digits each, the window doubles when that was too optimistic
+		std::uint32_t window = static_cast<std::uint32_t>(std::min(digits / 9 * 24 + 1024, static_cast<double>(MAX_WINDOW)));
+		std::vector<std::uint32_t> primes;
+
+		while (true)
+		{
+			const std::uint32_t low = BASE - window;
+			std::vector<bool> isWindowComposite(window, false);
+
+			for (const std::uint32_t divisor : divisors)
+			{
+				// a window reaching down to the divisors keeps them, their multiples start at the square
+				for (std::uint32_t j = std::max(divisor * divisor, (low + divisor - 1) / divisor * divisor); j < BASE; j += divisor)
+				{
+					isWindowComposite[j - low] = true;
+				}
+			}
+
+			primes.clear();
+
+			double productDigits = 0;
+
+			for (std::uint32_t i = BASE - 1; i >= low && productDigits <= digits; i -= 2)
+			{
+				if (!isWindowComposite[i - low])
+				{
+					primes.push_back(i);
+					productDigits += std::log10(static_cast<double>(i));
+				}
+			}
+
+			if (productDigits > digits || window == MAX_WINDOW)
+			{
+				return primes;
+			}
+
+			window = std::min(window * 2, MAX_WINDOW);
+		}
+	}
+}
+
+RnsBigInteger::Basis::Basis(const BigInteger& bound)
+{
+	const BigInteger range = (bound < 0 ? -bound : bound) * 2;
+	const size_t limbs = range.GetView().GetDigits().size();
+
+	// 2 * bound < 10^(9 * limbs), one decimal digit more covers the rounding of the logarithms
+	m_primes = FindPrimes(9.0 * static_cast<double>(limbs) + 1);
+	m_primeReciprocals.reserve(m_primes.size());
+
+	for (const std::uint32_t prime : m_primes)
+	{
+		m_primeReciprocals.push_back(1.0 / prime);
+	}
+
+	m_productTree.emplace_back(m_primes.begin(), m_primes.end());
+
+	while (m_productTree.back().size() > 1)
+	{
+		const std::vector<BigInteger>& below = m_productTree.back();
+		std::vector<BigInteger> level;
+
+		for (size_t i = 0; i + 1 < below.size(); i += 2)
+		{
+			level.push_back(below[i] * below[i + 1]);
+		}
+
+		if (below.size() % 2 == 1)
+		{
+			level.push_back(below.back());
+		}
+
+		m_productTree.push_back(std::move(level));
+	}
+
+	// short only past the primes below BASE
+	m_isValid = GetModulus() > range;
+
+	m_halfModulus = GetModulus() / 2;
+
+	// a basis of up to 2^LEAF_LEVEL primes is one leaf
+	m_leafLevel = std::min(LEAF_LEVEL, m_productTree.size() - 1);
+	m_reciprocalTree.resize(m_productTree.size());
+
+	for (size_t level = m_leafLevel; level < m_productTree.size(); ++level)
+	{
+		for (const BigInteger& product : m_productTree[level])
+		{
+			BigInteger shifted = product;
+
+			// two more limbs of precision, so a value up to BASE^(2s + 2) is reduced in one step
+			shifted.ShiftLimbs(2);
+			m_reciprocalTree[level].push_back(GetReciprocal(shifted));
+		}
+	}
+
+	// (M / P) mod P for each leaf node, then (M / p) mod p = ((M / P) mod p) * ((P / p) mod p) for its primes
+	const std::vector<BigInteger> cofactors = Descend(BigInteger{ 1 }, true);
+	const size_t leafSize = size_t{ 1 } << m_leafLevel;
+
+	m_cofactorInverses.resize(m_primes.size());
+
+	for (size_t i = 0; i < m_primes.size(); ++i)
+	{
+		const std::uint32_t prime = m_primes[i];
+		const size_t leaf = i >> m_leafLevel;
+		std::uint64_t cofactor = BigIntegerLimbs::RemainderByWord(cofactors[leaf].GetView().GetDigits(), prime);
+
+		for (size_t j = leaf * leafSize; j < std::min((leaf + 1) * leafSize, m_primes.size()); ++j)
+		{
+			if (j != i)
+			{
+				cofactor = cofactor * (m_primes[j] % prime) % prime;
+			}
+		}
+
+		m_cofactorInverses[i] = BigIntegerArithmetic::PowerMod(cofactor, prime - 2, prime);
+	}
+}
+
+bool RnsBigInteger::Basis::IsValid() const
+{
+	return m_isValid;
+}
+
+size_t RnsBigInteger::Basis::GetSize() const
+{
+	return m_primes.size();
+}
+
+std::span<const std::uint32_t> RnsBigInteger::Basis::GetPrimes() const
+{
+	return m_primes;
+}
+
+const BigInteger& RnsBigInteger::Basis::GetModulus() const
+{
+	return m_productTree.back()[0];
+}
+
+BigInteger RnsBigInteger::Basis::Reduce(BigInteger value, size_t level, size_t index) const
+{
+	const BigInteger& product = m_productTree[level][index];
+	const BigInteger& reciprocal = m_reciprocalTree[level][index];
+	const size_t window = 2 * GetLimbCount(product) + 2;
+
+	// a longer value has its top window reduced first, each pass shortens it by more than half a window
+	while (GetLimbCount(value) > window)
+	{
+		const size_t low = GetLimbCount(value) - window;
+		BigInteger top = value;
+
+		top.ShiftLimbs(-static_cast<std::ptrdiff_t>(low));
+		top = Reduce(std::move(top), level, index);
+		top.ShiftLimbs(static_cast<std::ptrdiff_t>(low));
+		value = top + GetLowLimbs(value, low);
+	}
+
+	// Barrett: the estimated quotient is at most 2 below the true one
+	BigInteger quotient = value * reciprocal;
+
+	quotient.ShiftLimbs(-static_cast<std::ptrdiff_t>(window));
+	value -= quotient * product;
+
+	while (value >= product)
+	{
+		value -= product;
+	}
+
+	return value;
+}
+
+std::vector<BigInteger> RnsBigInteger::Basis::Descend(BigInteger root, bool isCofactor) const
+{
+	std::vector<BigInteger> values;
+
+	values.push_back(std::move(root));
+
+	for (size_t level = m_productTree.size() - 1; level > m_leafLevel; --level)
+	{
+		const std::vector<BigInteger>& below = m_productTree[level - 1];
+		std::vector<BigInteger> next(below.size());
+
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			const size_t left = 2 * i;
+			const size_t right = left + 1;
+
+			// the last node of an odd level moved up alone, its product and value stay the same
+			if (right == below.size())
+			{
+				next[left] = std::move(values[i]);
+
+				continue;
+			}
+
+			next[left] = Reduce(isCofactor ? values[i] * below[right] : values[i], level - 1, left);
+			next[right] = Reduce(isCofactor ? values[i] * below[left] : std::move(values[i]), level - 1, right);
+		}
+
+		values = std::move(next);
+	}
+
+	return values;
+}
+
+void RnsBigInteger::Basis::GetResidues(const BigInteger& value, std::span<std::uint32_t> residues) const
+{
+	const std::vector<BigInteger> leaves = Descend(Reduce(value, m_productTree.size() - 1, 0), false);
+
+	for (size_t i = 0; i < m_primes.size(); ++i)
+	{
+		residues[i] = static_cast<std::uint32_t>(BigIntegerLimbs::RemainderByWord(leaves[i >> m_leafLevel].GetView().GetDigits(), m_primes[i]));
+	}
+}
+
+RnsBigInteger::RnsBigInteger(const Basis& basis)
+	: m_basis{ &basis }
+	, m_residues(basis.GetSize(), 0)
+{
+
+}
+
+RnsBigInteger::RnsBigInteger(const Basis& basis, const BigInteger& number)
+	: m_basis{ &basis }
+	, m_residues(basis.GetSize())
+{
+	basis.GetResidues(number.Abs(), m_residues);
+
+	if (number < 0)
+	{
+		for (size_t i = 0; i < m_residues.size(); ++i)
+		{
+			m_residues[i] = m_residues[i] != 0 ? basis.m_primes[i] - m_residues[i] : 0;
+		}
+	}
+}
+
+RnsBigInteger RnsBigInteger::operator+(const RnsBigInteger& other) const
+{
+	RnsBigInteger result = *this;
+
+	result += other;
+
+	return result;
+}
+
+RnsBigInteger RnsBigInteger::operator-(const RnsBigInteger& other) const
+{
+	RnsBigInteger result = *this;
+
+	result -= other;
+
+	return result;
+}
+
+RnsBigInteger RnsBigInteger::operator*(const RnsBigInteger& other) const
+{
+	RnsBigInteger result = *this;
+
+	result *= other;
+
+	return result;
+}
+
+RnsBigInteger RnsBigInteger::operator-() const
+{
+	RnsBigInteger result{ *m_basis };
+
+	result -= *this;
+
+	return result;
+}
+
+// the loops below touch each residue alone and work in 32-bit lanes without a division, so they vectorize
+
+RnsBigInteger& RnsBigInteger::operator+=(const RnsBigInteger& other)
+{
+	assert(m_basis == other.m_basis);
+
+	const std::uint32_t* primes = m_basis->m_primes.data();
+	const std::uint32_t* residues = other.m_residues.data();
+	std::uint32_t* out = m_residues.data();
+
+	for (size_t i = 0; i < m_residues.size(); ++i)
+	{
+		// both residues are below 10^9, the sum fits 32 bits
+		const std::uint32_t sum = out[i] + residues[i];
+
+		out[i] = sum >= primes[i] ? sum - primes[i] : sum;
+	}
+
+	return *this;
+}
+
+RnsBigInteger& RnsBigInteger::operator-=(const RnsBigInteger& other)
+{
+	assert(m_basis == other.m_basis);
+
+	const std::uint32_t* primes = m_basis->m_primes.data();
+	const std::uint32_t* residues = other.m_residues.data();
+	std::uint32_t* out = m_residues.data();
+
+	for (size_t i = 0; i < m_residues.size(); ++i)
+	{
+		// wraps below zero when the prime has to be added back
+		const std::uint32_t prime = primes[i];
+		const std::uint32_t difference = out[i] - residues[i];
+
+		out[i] = difference + (out[i] < residues[i] ? prime : 0);
+	}
+
+	return *this;
+}
+
+RnsBigInteger& RnsBigInteger::operator*=(const RnsBigInteger& other)
+{
+	assert(m_basis == other.m_basis);
+
+	const std::uint32_t* primes = m_basis->m_primes.data();
+	const std::uint32_t* residues = other.m_residues.data();
+	const double* reciprocals = m_basis->m_primeReciprocals.data();
+	std::uint32_t* out = m_residues.data();
+
+	for (size_t i = 0; i < m_residues.size(); ++i)
+	{
+		// the quotient estimated in double is off by at most one either way, so the remainder lies in (-p, 2p)
+		// and its low 32 bits are exact. Residues stay below 2^30, their product below 2^60.
+		const std::int32_t prime = static_cast<std::int32_t>(primes[i]);
+		const double product = static_cast<double>(static_cast<std::int32_t>(out[i])) * static_cast<std::int32_t>(residues[i]);
+		const std::int32_t quotient = static_cast<std::int32_t>(product * reciprocals[i]);
+		std::int32_t remainder = static_cast<std::int32_t>(out[i] * residues[i] - static_cast<std::uint32_t>(quotient) * primes[i]);
+
+		remainder += remainder < 0 ? prime : 0;
+		remainder -= remainder >= prime ? prime : 0;
+		out[i] = static_cast<std::uint32_t>(remainder);
+	}
+
+	return *this;
+}
+
+bool RnsBigInteger::operator==(const RnsBigInteger& other) const
+{
+	assert(m_basis == other.m_basis);
+
+	return m_residues == other.m_residues;
+}
+
+BigInteger RnsBigInteger::ToBigInteger() const
+{
+	const Basis& basis = *m_basis;
+
+	// value = sum of c_i * M / p_i mod M with c_i = r_i * ((M / p_i) mod p_i)^-1 mod p_i. The sum is
+	// built up the product tree, a node being left * M_right + right * M_left, so the large
+	// multiplications are balanced and take Karatsuba or the NTT.
+	std::vector<BigInteger> sums(m_residues.size());
+
+	for (size_t i = 0; i < m_residues.size(); ++i)
+	{
+		sums[i] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(m_residues[i]) * basis.m_cofactorInverses[i] % basis.m_primes[i]);
+	}
+
+	for (size_t level = 0; sums.size() > 1; ++level)
+	{
+		const std::vector<BigInteger>& products = basis.m_productTree[level];
+		std::vector<BigInteger> above;
+
+		for (size_t i = 0; i + 1 < sums.size(); i += 2)
+		{
+			above.push_back(sums[i] * products[i + 1] + sums[i + 1] * products[i]);
+		}
+
+		if (sums.size() % 2 == 1)
+		{
+			above.push_back(std::move(sums.back()));
+		}
+
+		sums = std::move(above);
+	}
+
+	BigInteger value = basis.Reduce(std::move(sums[0]), basis.m_productTree.size() - 1, 0);
+
+	if (value > basis.m_halfModulus)
+	{
+		value -= basis.GetModulus();
+	}
+
+	return value;
+}
+
+const RnsBigInteger::Basis& RnsBigInteger::GetBasis() const
+{
+	return *m_basis;
+}
+
+std::span<const std::uint32_t> RnsBigInteger::GetResidues() const
+{
+	return m_residues;
+}
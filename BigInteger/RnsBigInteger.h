@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "BigInteger.h"
+
+// A value as its residues modulo a set of primes below 10^9. Addition, subtraction and multiplication
+// work on each residue alone, without carries or normalization, so a long chain of them costs one
+// word operation per prime each. The value comes back through the CRT only when ToBigInteger is called.
+//
+// The result of every step has to stay within the bound the basis was built for, a value past it
+// wraps around silently.
+class RnsBigInteger
+{
+public:
+	// the primes and the CRT constants shared by all values of one bound. Values keep a pointer to their
+	// basis, so it has to outlive them and cannot be copied or moved. The bound takes about one prime
+	// per limb. Building the basis and converting into and out of it walk the product tree with
+	// Barrett reductions, O(M(n) log n) for n limbs.
+	//
+	// The primes below 10^9 cover bounds of about 4.5 * 10^8 digits. A basis for a larger bound is not
+	// valid and its values wrap.
+	class Basis
+	{
+		friend class RnsBigInteger;
+
+	private:
+		std::vector<std::uint32_t> m_primes;
+		// 1.0 / p for each prime, the quotient estimate of a residue product
+		std::vector<double> m_primeReciprocals;
+		// ((M / p) mod p)^-1 mod p for each prime p, M the product of all of them
+		std::vector<std::uint32_t> m_cofactorInverses;
+		// level 0 holds the primes, each level above the products of pairs from the one below, the last
+		// node of an odd level moves up alone. The top level is M.
+		std::vector<std::vector<BigInteger>> m_productTree;
+		// floor(BASE^(2s + 2) / P) for the nodes from m_leafLevel up, P of s limbs
+		std::vector<std::vector<BigInteger>> m_reciprocalTree;
+		// nodes of this level are split into their primes with word operations
+		size_t m_leafLevel;
+		BigInteger m_halfModulus;
+		bool m_isValid;
+
+	public:
+		// room for every value with |value| < bound, a bound of 0 or 1 still gets one prime
+		explicit Basis(const BigInteger& bound);
+		Basis(const Basis&) = delete;
+		Basis& operator=(const Basis&) = delete;
+
+		// false when the primes below 10^9 were not enough for the bound
+		bool IsValid() const;
+		size_t GetSize() const;
+		std::span<const std::uint32_t> GetPrimes() const;
+		const BigInteger& GetModulus() const;
+
+	private:
+		// value mod the node's product, value must not be negative
+		BigInteger Reduce(BigInteger value, size_t level, size_t index) const;
+		// carries the root value down to the nodes of m_leafLevel, each child taking its parent reduced by
+		// its own product. For cofactors the parent is first multiplied by the sibling's product, so a
+		// root of 1 ends as (M / P) mod P in every node.
+		std::vector<BigInteger> Descend(BigInteger root, bool isCofactor) const;
+		// residues of a value that is not negative
+		void GetResidues(const BigInteger& value, std::span<std::uint32_t> residues) const;
+	};
+
+private:
+	const Basis* m_basis;
+	std::vector<std::uint32_t> m_residues;
+
+public:
+	// zero
+	explicit RnsBigInteger(const Basis& basis);
+	RnsBigInteger(const Basis& basis, const BigInteger& number);
+
+public:
+	// both operands have to share one basis
+	RnsBigInteger operator+(const RnsBigInteger& other) const;
+	RnsBigInteger operator-(const RnsBigInteger& other) const;
+	RnsBigInteger operator*(const RnsBigInteger& other) const;
+	RnsBigInteger operator-() const;
+
+	RnsBigInteger& operator+=(const RnsBigInteger& other);
+	RnsBigInteger& operator-=(const RnsBigInteger& other);
+	RnsBigInteger& operator*=(const RnsBigInteger& other);
+
+	bool operator==(const RnsBigInteger& other) const;
+
+	// the value in [-(M - 1) / 2, (M - 1) / 2], where M is the product of the primes
+	BigInteger ToBigInteger() const;
+
+	const Basis& GetBasis() const;
+	std::span<const std::uint32_t> GetResidues() const;
+};
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BigInteger.h"
+#include "BigIntegerMappedFile.h"
+#include "BigIntegerOutOfCore.h"
+#include "BigIntegerSerialization.h"
+
+namespace
+{
+	// 64 values, so rows of at most 64 columns and a panel of a few columns
+	constexpr size_t SMALL_BUDGET = 256;
+
+	BigInteger RandomNumber(std::mt19937_64& random, size_t limbs)
+	{
+		std::uniform_int_distribution<int> digit{ 0, 9 };
+		std::string text(limbs * 9, '0');
+
+		for (char& c : text)
+		{
+			c = static_cast<char>('0' + digit(random));
+		}
+
+		text[0] = std::max(text[0], '1');
+
+		return BigInteger{ text };
+	}
+
+	// the number of 9 * limbs nines, whose products carry through every limb
+	BigInteger Nines(size_t limbs)
+	{
+		return BigInteger{ std::string(limbs * 9, '9') };
+	}
+
+	// the value serialized at path, false when it cannot be read
+	bool ReadValue(const std::string& path, BigInteger& number)
+	{
+		BigIntegerMappedFile file;
+		size_t size = 0;
+
+		return file.Open(path) && BigIntegerSerialization::Deserialize(file.GetBytes(), number, size) && size == file.GetBytes().size();
+	}
+
+	bool WriteValue(const std::string& path, const BigInteger& number)
+	{
+		std::vector<std::uint8_t> bytes;
+
+		BigIntegerSerialization::Serialize(number.GetView(), bytes);
+
+		std::ofstream output{ path, std::ios::binary };
+
+		output.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+		return static_cast<bool>(output);
+	}
+
+	// the out of core product of a and b at path against operator*, and no scratch or partial file left behind
+	bool Check(const BigInteger& a, const BigInteger& b, const std::string& path, size_t memoryBudget)
+	{
+		BigInteger product;
+
+		if (!BigIntegerOutOfCore::Multiply(a.GetView(), b.GetView(), path, memoryBudget) || !ReadValue(path, product))
+		{
+			std::cerr << "no product written to " << path << "\n";
+
+			return false;
+		}
+
+		if (std::filesystem::exists(path + ".scratch") || std::filesystem::exists(path + ".partial"))
+		{
+			std::cerr << "scratch or partial file left next to " << path << "\n";
+
+			return false;
+		}
+
+		if (product != a * b)
+		{
+			std::cerr << a.GetView().GetDigits().size() << " by " << b.GetView().GetDigits().size() << " limbs within "
+				<< memoryBudget << " bytes differs from operator*\n";
+
+			return false;
+		}
+
+		return true;
+	}
+
+	// the product written over the file the first operand is mapped from
+	bool CheckInPlace(const BigInteger& a, const BigInteger& b, const std::string& path)
+	{
+		BigIntegerMappedFile file;
+		BigIntegerView view;
+		size_t size = 0;
+
+		if (!WriteValue(path, a) || !file.Open(path) || !BigIntegerSerialization::DeserializeView(file.GetBytes(), view, size))
+		{
+			std::cerr << "cannot map the operand at " << path << "\n";
+
+			return false;
+		}
+
+		BigInteger product;
+
+		if (!BigIntegerOutOfCore::Multiply(view, b.GetView(), path, SMALL_BUDGET) || !ReadValue(path, product) || product != a * b)
+		{
+			std::cerr << "product over its own operand differs from operator*\n";
+
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main()
+{
+	const std::string path = (std::filesystem::temp_directory_path() / "BigIntegerOutOfCoreTest.bin").string();
+
+	std::mt19937_64 random{ 20240601 };
+	bool isPassing = true;
+
+	// one row: the whole product fits a transform
+	for (const auto& [aLimbs, bLimbs] : { std::pair<size_t, size_t>{ 1, 1 }, { 3, 5 }, { 1000, 1 }, { 4096, 4095 }, { 30000, 7 } })
+	{
+		isPassing &= Check(RandomNumber(random, aLimbs), -RandomNumber(random, bLimbs), path, BigIntegerOutOfCore::DEFAULT_MEMORY_BUDGET);
+	}
+
+	// many rows: the short rows cut the operands into pieces
+	for (const auto& [aLimbs, bLimbs] : { std::pair<size_t, size_t>{ 65, 1 }, { 33, 33 }, { 1000, 1000 }, { 3000, 7 }, { 7, 3000 }, { 2500, 1700 } })
+	{
+		isPassing &= Check(RandomNumber(random, aLimbs), -RandomNumber(random, bLimbs), path, SMALL_BUDGET);
+	}
+
+	isPassing &= Check(Nines(2000), Nines(1500), path, SMALL_BUDGET);
+	isPassing &= Check(Nines(2000), Nines(1500), path, BigIntegerOutOfCore::DEFAULT_MEMORY_BUDGET);
+	isPassing &= Check(BigInteger{ 0 }, -RandomNumber(random, 100), path, SMALL_BUDGET);
+	isPassing &= CheckInPlace(RandomNumber(random, 500), RandomNumber(random, 300), path);
+
+	std::error_code error;
+
+	std::filesystem::remove(path, error);
+
+	std::cout << (isPassing ? "out of core products agree with operator*\n" : "out of core products differ\n");
+
+	return isPassing ? 0 : 1;
+}